@@ -6,6 +6,8 @@
 
 struct BuildEnv {
     std::string buildDirectory = "./neon-build/";
+    // reuses the trees of modules that have not changed since the last build, see ModuleCache
+    bool cacheModules = true;
 
     explicit BuildEnv() { createBuildDir(); }
     explicit BuildEnv(std::string buildDir) : buildDirectory(std::move(buildDir)) {
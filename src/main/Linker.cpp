@@ -109,6 +109,8 @@ bool Linker::link() {
     std::string linkerCommand = getLinkerCommand();
 
     log.debug("Calling linker with the following command:\n" + linkerCommand);
+    // the linker writes to stdout as well
+    log.flush();
 
     // TODO(henne): capture stdout and stderr. only print to console when verbose==true
     const char *command = linkerCommand.c_str();
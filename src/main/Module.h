@@ -15,9 +15,9 @@
 
 class Module {
   public:
-    explicit Module(std::filesystem::path _filePath, llvm::LLVMContext &context)
+    explicit Module(std::filesystem::path _filePath)
         : filePath(std::move(_filePath)), codeProvider(new FileCodeProvider(_filePath)),
-          llvmModule(_filePath.string(), context) {}
+          llvmModule(_filePath.string(), llvmContext) {}
 
     [[nodiscard]] std::string toString() const;
     [[nodiscard]] std::string toEscapedString() const;
@@ -32,8 +32,11 @@ class Module {
     CodeProvider *codeProvider;
 
     AST ast;
+    // NOTE the tokens point into the source buffer that is owned by the code provider
     std::vector<Token> tokens = {};
 
+    // every module has its own context, so that the IR of all modules can be generated in parallel
+    llvm::LLVMContext llvmContext;
     llvm::Module llvmModule;
 
   private:
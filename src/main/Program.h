@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Module.h"
+#include "compiler/SymbolTable.h"
 
 #include <llvm/IR/LLVMContext.h>
 #include <string>
@@ -16,6 +17,9 @@ class Program {
     std::string name;
 
     std::unordered_map<std::string, Module *> modules = {};
+    // identifiers of all modules are interned into the same table, so symbols can be compared across modules
+    SymbolTable symbolTable = {};
+    // NOTE the modules generate their IR in their own contexts, this one only holds the module they are linked into
     llvm::LLVMContext llvmContext = {};
 
     [[nodiscard]] std::string objectFileName() const;
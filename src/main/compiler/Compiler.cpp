@@ -3,64 +3,124 @@
 #include "FunctionResolver.h"
 #include "ast/visitors/AstPrinter.h"
 #include "ast/visitors/AstTestCasePrinter.h"
-#include "ast/visitors/ComplexTypeFinder.h"
-#include "ast/visitors/FunctionFinder.h"
-#include "ast/visitors/ImportFinder.h"
+#include "ast/visitors/DeclarationFinder.h"
 #include "ast/visitors/TypeAnalyzer.h"
 #include "ir/IrGenerator.h"
 #include "parser/Parser.h"
+#include "util/ThreadPool.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Linker/Linker.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
-#include <llvm/Transforms/Utils/Cloning.h>
 
-bool Compiler::run() {
-    std::vector<std::string> uncompiledModulePaths = {program->entryPoint};
-    while (!uncompiledModulePaths.empty()) {
-        std::string moduleFileName = uncompiledModulePaths.back();
-        uncompiledModulePaths.pop_back();
+namespace {
 
-        auto itr = program->modules.find(moduleFileName);
-        bool moduleAlreadyExists = itr != program->modules.end();
-        if (moduleAlreadyExists) {
-            log.debug("Skipping " + moduleFileName + " because it has already been processed");
-            continue;
-        }
+std::string describeArena(const std::string &moduleFileName, const AstArenaStatistics &statistics) {
+    return "AST arena of " + moduleFileName + ": " + std::to_string(statistics.nodeCount) + " nodes in " +
+           std::to_string(statistics.chunkCount) + " chunks, " + std::to_string(statistics.bytesReserved / 1024) +
+           "KiB reserved";
+}
 
-        auto *module = loadModule(moduleFileName);
-        if (!module->ast.is_complete()) {
-            log.error("Failed to compile module " + moduleFileName);
-            return true;
-        }
-        program->modules[moduleFileName] = module;
+} // namespace
 
-        for (auto &importedModule : moduleCompileState[module].imports) {
-            uncompiledModulePaths.push_back(importedModule);
-        }
+bool Compiler::run() {
+    if (!loadModules()) {
+        return true;
     }
 
+    symbolIndex.build(program, moduleCompileState);
+
     analyseTypes();
 
-    generateIR();
+    if (!generateIR()) {
+        return true;
+    }
 
     writeModuleToObjectFile();
 
     log.debug("Finished compilation.");
+    log.flush();
     return false;
 }
 
-Module *Compiler::loadModule(const std::string &moduleFileName) {
-    auto *module = new Module(moduleFileName, program->llvmContext);
+bool Compiler::loadModules() {
+    loadingFailed = false;
+    scheduleModule(program->entryPoint);
+    threadPool.wait();
+    if (loadingFailed) {
+        return false;
+    }
+
+    orderedModules.clear();
+    for (const auto &entry : program->modules) {
+        orderedModules.push_back(entry.second);
+    }
+    std::sort(orderedModules.begin(), orderedModules.end(), [](const Module *a, const Module *b) {
+        return a->getFilePath().string() < b->getFilePath().string();
+    });
+    return true;
+}
+
+void Compiler::scheduleModule(const std::string &moduleFileName) {
+    Module *module = nullptr;
+    bool moduleAlreadyExists = false;
+    {
+        // the path is claimed under the lock, so that every module is only loaded once
+        std::lock_guard lock(modulesMutex);
+        auto itr = program->modules.find(moduleFileName);
+        moduleAlreadyExists = itr != program->modules.end();
+        if (!moduleAlreadyExists) {
+            module = new Module(moduleFileName);
+            program->modules[moduleFileName] = module;
+        }
+    }
+    if (moduleAlreadyExists) {
+        LOG_DEBUG(log, "Skipping " + moduleFileName + " because it has already been processed");
+        return;
+    }
+
+    modulesPending++;
+    threadPool.submit([this, module, moduleFileName]() {
+        if (loadingFailed) {
+            modulesPending--;
+            return;
+        }
+
+        auto state = ModuleCompileState();
+        loadModule(module, state);
+        modulesPending--;
+        if (!module->ast.is_complete()) {
+            log.error("Failed to compile module " + moduleFileName);
+            loadingFailed = true;
+            return;
+        }
+
+        // loading a module doesn't depend on its imports, so they are started as soon as they are known
+        for (const auto &importedModule : state.imports) {
+            scheduleModule(importedModule);
+        }
+
+        std::lock_guard lock(modulesMutex);
+        moduleCompileState[module] = std::move(state);
+    });
+}
+
+void Compiler::loadModule(Module *module, ModuleCompileState &state) {
+    const auto moduleFileName = module->getFilePath().string();
 
     if (module->getFilePath().has_parent_path()) {
         const auto moduleBuildDir =
@@ -68,55 +128,105 @@ Module *Compiler::loadModule(const std::string &moduleFileName) {
         std::filesystem::create_directories(moduleBuildDir);
     }
 
-    Lexer lexer(module->getCodeProvider(), log);
+    const auto sourceHash = buildEnv->cacheModules ? ModuleCache::hashSource(module->getFilePath()) : std::nullopt;
+    if (!sourceHash || !moduleCache.load(module, *sourceHash)) {
+        Lexer lexer(module->getCodeProvider(), program->symbolTable, log);
+
+        // the workers of the pool already keep the hardware threads busy while other modules are waiting to be loaded,
+        // so only a module that is loaded on its own gets threads of its own for lexing and parsing
+        const auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        const bool loadedAlone = modulesPending.load() <= 1;
+        const ParserOptions parserOptions = {
+              .keepTokens = log.getLogLevel() == Logger::LogLevel::DEBUG_,
+              .lexInBackground = loadedAlone && hardwareThreads > 1,
+              .parseThreads = loadedAlone ? hardwareThreads : 1,
+        };
+        Parser parser(log, lexer, parserOptions);
+        parser.run(module);
 
-    Parser parser(log, lexer);
-    parser.run(module);
-
-    if (!module->ast.is_complete()) {
-        log.error("Could not parse '" + moduleFileName + "'");
-        return module;
-    }
+        if (!module->ast.is_complete()) {
+            log.error("Could not parse '" + moduleFileName + "'");
+            return;
+        }
 
-    if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
-        // TODO enable this again
-        //        auto astPrinter = AstPrinter(module);
-        //        astPrinter.run();
-        // TODO enable this again
-        //        auto astTestCasePrinter = AstTestCasePrinter(module);
-        //        astTestCasePrinter.run();
+        if (sourceHash) {
+            moduleCache.store(module, *sourceHash);
+        }
     }
 
-    moduleCompileState[module].imports = ImportFinder(module->getDirectoryPath()).run(module->ast);
-    moduleCompileState[module].functions = FunctionFinder().run(module->ast);
-    moduleCompileState[module].complexTypes = ComplexTypeFinder().run(module->ast);
+    LOG_DEBUG(log, describeArena(moduleFileName, module->ast.arenaStatistics()));
+    LOG_DEBUG(log, AstPrinter(program->symbolTable).run(module->ast));
+    // TODO enable this again
+    //        auto astTestCasePrinter = AstTestCasePrinter(module);
+    //        astTestCasePrinter.run();
 
-    return module;
+    DeclarationFinder(module->getDirectoryPath(), program->symbolTable).run(module->ast, state);
 }
 
-void Compiler::generateIR() {
-    auto functionResolver = FunctionResolver(program, moduleCompileState);
-    for (const auto &entry : program->modules) {
-        auto *module = entry.second;
-        auto typeResolver = TypeResolver(program, moduleCompileState);
-        auto generator = IrGenerator(buildEnv, module, functionResolver, typeResolver, log);
-        generator.run();
+bool Compiler::generateIR() {
+    // every module has its own LLVM context, so the generators don't share any state and can run in parallel
+    const auto functionResolver = FunctionResolver(symbolIndex);
+    const auto typeResolver = TypeResolver(symbolIndex, moduleCompileState);
+    const auto &modules = orderedModules;
+
+    // the errors are collected per module and only printed once all generators are done, in the order of the modules
+    std::vector<std::vector<std::string>> errors(modules.size());
+    for (size_t i = 0; i < modules.size(); i++) {
+        threadPool.submit([this, &functionResolver, &typeResolver, &modules, &errors, i]() {
+            auto generator =
+                  IrGenerator(buildEnv, modules[i], program->symbolTable, functionResolver, typeResolver, log);
+            if (!generator.run()) {
+                errors[i] = generator.getErrors();
+            }
+        });
+    }
+    threadPool.wait();
+
+    bool success = true;
+    for (const auto &moduleErrors : errors) {
+        if (!moduleErrors.empty()) {
+            IrGenerator::printErrors(moduleErrors);
+            success = false;
+        }
     }
+    return success;
 }
 
 void Compiler::mergeModules(llvm::Module &destinationModule, const llvm::DataLayout &dataLayout,
                             const std::string &targetTriple) {
     // To be able to link modules, they have to be in the same context.
     // To create modules in parallel, they can't share a context.
-    // One can work around this issue, by writing all the modules into a buffer first and then reading them in again
-    // with the correct context
-
-    for (auto &mod : program->modules) {
-        llvm::Module &llvmModule = mod.second->llvmModule;
-        llvmModule.setDataLayout(dataLayout);
-        llvmModule.setTargetTriple(targetTriple);
+    // That's why all the modules are written into a bitcode buffer first, which is done in parallel. The buffers are then
+    // read in again lazily with the context of the destination module.
+    // NOTE the modules are linked in a stable order, which decides the order of the functions and global constructors
+    // in the output
+    const auto &modules = orderedModules;
+
+    std::vector<llvm::SmallVector<char, 0>> bitcodeBuffers(modules.size());
+    for (size_t i = 0; i < modules.size(); i++) {
+        threadPool.submit([&modules, &bitcodeBuffers, &dataLayout, &targetTriple, i]() {
+            llvm::Module &llvmModule = modules[i]->llvmModule;
+            llvmModule.setDataLayout(dataLayout);
+            llvmModule.setTargetTriple(targetTriple);
+
+            llvm::raw_svector_ostream stream(bitcodeBuffers[i]);
+            llvm::WriteBitcodeToFile(llvmModule, stream);
+        });
+    }
+    threadPool.wait();
+
+    // NOTE the lazily loaded modules read from the buffers until they are linked, so the buffers have to outlive them
+    for (size_t i = 0; i < modules.size(); i++) {
+        const auto bitcode = llvm::MemoryBufferRef(llvm::StringRef(bitcodeBuffers[i].data(), bitcodeBuffers[i].size()),
+                                                   modules[i]->getFilePath().string());
+        auto loadedModule = llvm::getLazyBitcodeModule(bitcode, destinationModule.getContext());
+        if (!loadedModule) {
+            std::cerr << "Could not load module " << modules[i]->getFilePath().string() << ": "
+                      << llvm::toString(loadedModule.takeError()) << std::endl;
+            exit(1);
+        }
 
-        auto error = llvm::Linker::linkModules(destinationModule, llvm::CloneModule(llvmModule));
+        auto error = llvm::Linker::linkModules(destinationModule, std::move(*loadedModule));
         if (error) {
             std::cerr << "Could not link modules" << std::endl;
             exit(1);
@@ -196,11 +306,34 @@ void Compiler::writeModuleToObjectFile() {
 }
 
 void Compiler::analyseTypes() {
-    for (auto &entry : program->modules) {
-        auto &module = entry.second;
-        auto functionResolver = FunctionResolver(program, moduleCompileState);
-        auto result = TypeAnalyzer(log, module, functionResolver).run(module->ast);
-        moduleCompileState[module].nodeToTypeMap = result.first;
-        moduleCompileState[module].nameToTypeMap = result.second;
+    // analysing a module only reads the declarations of the other modules, so all modules are analysed in parallel
+    const auto functionResolver = FunctionResolver(symbolIndex);
+    const auto typeResolver = TypeResolver(symbolIndex, moduleCompileState);
+    const auto &modules = orderedModules;
+
+    // like the results, the errors are collected per module and only printed once all modules are done
+    std::vector<std::pair<NodeMap<ast::DataType>, std::unordered_map<Symbol, ast::DataType>>> results(modules.size());
+    std::vector<std::vector<std::string>> errors(modules.size());
+    for (size_t i = 0; i < modules.size(); i++) {
+        threadPool.submit([this, &functionResolver, &typeResolver, &modules, &results, &errors, i]() {
+            auto *module = modules[i];
+            auto analyzer = TypeAnalyzer(log, module, program->symbolTable, functionResolver, typeResolver);
+            results[i] = analyzer.run(module->ast);
+            errors[i] = analyzer.getErrors();
+        });
+    }
+    threadPool.wait();
+
+    for (const auto &moduleErrors : errors) {
+        for (const auto &msg : moduleErrors) {
+            std::cerr << msg << std::endl;
+        }
+    }
+
+    // the results are only stored once all modules are done, so no thread reads a compile state while it is written
+    for (size_t i = 0; i < modules.size(); i++) {
+        auto &state = moduleCompileState.at(modules[i]);
+        state.nodeToTypeMap = std::move(results[i].first);
+        state.nameToTypeMap = std::move(results[i].second);
     }
 }
@@ -2,13 +2,21 @@
 
 #include "../BuildEnv.h"
 #include "../Program.h"
+#include "../util/ThreadPool.h"
 #include "MetaTypes.h"
+#include "ModuleCache.h"
 #include "ModuleCompileState.h"
+#include "SymbolIndex.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 class Compiler {
   public:
     Compiler(Program *program, const BuildEnv *buildEnv, const Logger &logger)
-        : program(program), buildEnv(buildEnv), log(logger) {}
+        : program(program), buildEnv(buildEnv), log(logger), moduleCache(buildEnv, program->symbolTable, logger) {}
 
     bool run();
 
@@ -16,13 +24,31 @@ class Compiler {
     Program *program;
     const BuildEnv *buildEnv;
     const Logger &log;
+    ModuleCache moduleCache;
+
+    // guards program->modules and moduleCompileState while the modules are loaded in parallel
+    std::mutex modulesMutex = {};
+    std::atomic<bool> loadingFailed = false;
+    // modules that have been scheduled, but are not loaded yet
+    std::atomic<unsigned int> modulesPending = 0;
 
+    // all modules sorted by their path, the phases after loading go through the modules in this order, so that the
+    // output doesn't depend on the order in which the modules were loaded
+    std::vector<Module *> orderedModules = {};
+
+    // NOTE entries are only added while loading the modules, the later phases write into the existing entries
     std::unordered_map<Module *, ModuleCompileState> moduleCompileState = {};
+    SymbolIndex symbolIndex = {};
+
+    // declared last, so that the workers are stopped before anything they could use is destroyed
+    ThreadPool threadPool{std::thread::hardware_concurrency()};
 
-    Module *loadModule(const std::string &moduleFileName);
+    bool loadModules();
+    void scheduleModule(const std::string &moduleFileName);
+    void loadModule(Module *module, ModuleCompileState &state);
     void writeModuleToObjectFile();
     void mergeModules(llvm::Module &destinationModule, const llvm::DataLayout &dataLayout,
                       const std::string &targetTriple);
-    void generateIR();
+    bool generateIR();
     void analyseTypes();
 };
@@ -1,28 +1,14 @@
 #pragma once
 
 #include "../Program.h"
-#include "MetaTypes.h"
-#include "ModuleCompileState.h"
-
-#include <string>
-#include <unordered_map>
-
-struct FunctionResolveResult {
-    bool functionExists = false;
-    FunctionSignature signature = {
-          .returnType = ast::DataType(),
-    };
-    // TODO do we really need this?
-    Module *module = nullptr;
-};
+#include "SymbolIndex.h"
 
 class FunctionResolver {
   public:
-    FunctionResolver(Program *program, std::unordered_map<Module *, ModuleCompileState> &moduleCompileState)
-        : program(program), moduleCompileState(moduleCompileState) {}
+    explicit FunctionResolver(const SymbolIndex &symbolIndex) : symbolIndex(symbolIndex) {}
 
-    FunctionResolveResult resolveFunction(Module *module, const std::string &functionName) const;
+    [[nodiscard]] FunctionResolveResult resolveFunction(Module *module, Symbol functionName) const;
 
-    Program *program;
-    std::unordered_map<Module *, ModuleCompileState> &moduleCompileState;
+  private:
+    const SymbolIndex &symbolIndex;
 };
@@ -1,61 +1,301 @@
 #include "Logger.h"
 
-Logger::Logger() {
-#ifdef WIN32
-    // NOTE printing an empty line to enable colors for this terminal session
-    system("echo.");
-#endif
-}
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
 
-void Logger::log(const Logger::LogLevel level, const std::string& msg) const {
-    if (logLevel > level) {
-        return;
+struct LogMessage {
+    Logger::LogLevel level = Logger::DEBUG_;
+    bool colorEnabled = false;
+    bool jsonEnabled = false;
+    int64_t timestampMillis = 0;
+    std::string text;
+};
+
+// A bounded multi producer, single consumer ring buffer. Producers claim a slot by advancing enqueuePosition and
+// publish it by bumping the slot's sequence number. The writer thread is the only consumer and formats all messages
+// it finds into one batch, before writing the batch to stdout.
+class LogBuffer {
+  public:
+    ~LogBuffer() {
+        if (!writerThread.joinable()) {
+            return;
+        }
+        stopping.store(true, std::memory_order_release);
+        wakeUp();
+        writerThread.join();
     }
 
-    auto now = std::chrono::system_clock::now();
-    auto nowTimeT = std::chrono::system_clock::to_time_t(now);
-
-    std::string levelStr;
-    switch (level) {
-    case DEBUG_:
-        levelStr = "DEBG";
-        break;
-    case INFO:
-        levelStr = "INFO";
-        break;
-    case WARNING:
-        levelStr = "WARN";
-        break;
-    case ERROR:
-        levelStr = "ERRO";
-        break;
-    case DISABLED:
-        break;
-    }
-    std::string colorStr;
-    if (colorEnabled) {
-        switch (level) {
-        case DEBUG_:
+    void push(LogMessage &message) {
+        // NOTE most loggers never print anything, the buffer and the writer thread are only created on first use
+        std::call_once(writerStarted, [this]() { startWriter(); });
+
+        while (!tryPush(message)) {
+            // the buffer is full, wait for the writer to catch up instead of dropping messages
+            wakeUp();
+            std::this_thread::yield();
+        }
+        wakeUp();
+    }
+
+    void flush() {
+        if (!writerRunning.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        const auto target = enqueuePosition.load(std::memory_order_acquire);
+        auto current = writtenPosition.load(std::memory_order_acquire);
+        while (current < target) {
+            wakeUp();
+            writtenPosition.wait(current, std::memory_order_acquire);
+            current = writtenPosition.load(std::memory_order_acquire);
+        }
+    }
+
+  private:
+    static const size_t CAPACITY = 4096;
+
+    struct Slot {
+        std::atomic<size_t> sequence = 0;
+        LogMessage message = {};
+    };
+
+    std::vector<Slot> slots = {};
+    std::atomic<size_t> enqueuePosition = 0;
+    std::atomic<size_t> writtenPosition = 0;
+    std::atomic<uint32_t> wakeUps = 0;
+    std::atomic<bool> stopping = false;
+    std::atomic<bool> writerRunning = false;
+
+    // only used by the writer thread
+    size_t dequeuePosition = 0;
+    std::string batch = {};
+    int64_t cachedSecond = -1;
+    std::string cachedTimestamp = {};
+
+    std::once_flag writerStarted = {};
+    std::thread writerThread = {};
+
+    void startWriter() {
+        slots = std::vector<Slot>(CAPACITY);
+        for (size_t i = 0; i < CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writerThread = std::thread(&LogBuffer::runWriter, this);
+        writerRunning.store(true, std::memory_order_release);
+    }
+
+    void wakeUp() {
+        wakeUps.fetch_add(1, std::memory_order_release);
+        wakeUps.notify_one();
+    }
+
+    bool tryPush(LogMessage &message) {
+        auto position = enqueuePosition.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        while (true) {
+            slot = &slots[position % CAPACITY];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->message = std::move(message);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(LogMessage &message) {
+        auto &slot = slots[dequeuePosition % CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            return false;
+        }
+        message = std::move(slot.message);
+        slot.sequence.store(dequeuePosition + CAPACITY, std::memory_order_release);
+        dequeuePosition++;
+        return true;
+    }
+
+    void runWriter() {
+        LogMessage message = {};
+        while (true) {
+            const auto seenWakeUps = wakeUps.load(std::memory_order_acquire);
+            const bool stop = stopping.load(std::memory_order_acquire);
+
+            batch.clear();
+            while (tryPop(message)) {
+                format(message);
+            }
+
+            if (batch.empty()) {
+                if (stop) {
+                    return;
+                }
+                wakeUps.wait(seenWakeUps, std::memory_order_acquire);
+                continue;
+            }
+
+            std::fwrite(batch.data(), 1, batch.size(), stdout);
+            std::fflush(stdout);
+            writtenPosition.store(dequeuePosition, std::memory_order_release);
+            writtenPosition.notify_all();
+        }
+    }
+
+    const std::string &formatTimestamp(int64_t timestampMillis) {
+        // NOTE formatting the local time is expensive, but the output only has a resolution of one second
+        const auto second = timestampMillis / 1000;
+        if (second != cachedSecond) {
+            auto timeT = static_cast<std::time_t>(second);
+            char str[32];
+            std::strftime(str, sizeof(str), "%Y-%m-%d %X", std::localtime(&timeT));
+            cachedTimestamp = str;
+            cachedSecond = second;
+        }
+        return cachedTimestamp;
+    }
+
+    void format(const LogMessage &message) {
+        if (message.jsonEnabled) {
+            formatJson(message);
+            return;
+        }
+
+        const char *levelStr = "";
+        const char *colorStr = "";
+        switch (message.level) {
+        case Logger::DEBUG_:
+            levelStr = "DEBG";
             colorStr = "\u001b[36m";
             break;
-        case INFO:
+        case Logger::INFO:
+            levelStr = "INFO";
             colorStr = "\u001b[92m";
             break;
-        case WARNING:
+        case Logger::WARNING:
+            levelStr = "WARN";
             colorStr = "\u001b[93m";
             break;
-        case ERROR:
+        case Logger::ERROR:
+            levelStr = "ERRO";
             colorStr = "\u001b[91m";
             break;
-        case DISABLED:
+        case Logger::DISABLED:
+            break;
+        }
+
+        if (message.colorEnabled) {
+            batch += colorStr;
+        }
+        batch += "[";
+        batch += formatTimestamp(message.timestampMillis);
+        batch += "] - [";
+        batch += levelStr;
+        batch += "] ";
+        batch += message.text;
+        if (message.colorEnabled) {
+            batch += "\u001b[0m";
+        }
+        batch += "\n";
+    }
+
+    void formatJson(const LogMessage &message) {
+        const char *levelStr = "";
+        switch (message.level) {
+        case Logger::DEBUG_:
+            levelStr = "debug";
+            break;
+        case Logger::INFO:
+            levelStr = "info";
+            break;
+        case Logger::WARNING:
+            levelStr = "warning";
+            break;
+        case Logger::ERROR:
+            levelStr = "error";
+            break;
+        case Logger::DISABLED:
             break;
         }
+
+        batch += R"({"timestamp":)";
+        batch += std::to_string(message.timestampMillis);
+        batch += R"(,"level":")";
+        batch += levelStr;
+        batch += R"(","message":")";
+        for (char c : message.text) {
+            switch (c) {
+            case '"':
+                batch += "\\\"";
+                break;
+            case '\\':
+                batch += "\\\\";
+                break;
+            case '\n':
+                batch += "\\n";
+                break;
+            case '\r':
+                batch += "\\r";
+                break;
+            case '\t':
+                batch += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    batch += escaped;
+                } else {
+                    batch += c;
+                }
+            }
+        }
+        batch += "\"}\n";
+    }
+};
+
+Logger::Logger() : buffer(std::make_unique<LogBuffer>()) {
+#ifdef WIN32
+    // NOTE printing an empty line to enable colors for this terminal session
+    system("echo.");
+#endif
+}
+
+Logger::~Logger() = default;
+
+void Logger::log(const Logger::LogLevel level, const std::string& msg) const {
+    if (!isEnabled(level)) {
+        return;
     }
+    write(level, msg);
+}
 
-    std::cout << colorStr << "[" << std::put_time(std::localtime(&nowTimeT), "%Y-%m-%d %X") << "] - [" << levelStr
-              << "] " << msg;
-    if (colorEnabled) {
-        std::cout << "\u001b[0m";
+void Logger::write(const Logger::LogLevel level, const std::string &msg) const {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    LogMessage message = {
+          .level = level,
+          .colorEnabled = colorEnabled,
+          .jsonEnabled = jsonEnabled,
+          .timestampMillis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count(),
+          .text = msg,
+    };
+    buffer->push(message);
+
+    if (level >= LogLevel::WARNING) {
+        // the compiler might exit right after reporting an error
+        flush();
     }
-    std::cout << "\n";
 }
+
+void Logger::flush() const { buffer->flush(); }
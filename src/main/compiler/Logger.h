@@ -3,8 +3,35 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 
+// Use these macros instead of calling Logger::debug directly in hot paths. The message is only evaluated, if the logger
+// is going to print it.
+#define LOG_AT_LEVEL(logger, level, msg)                                                                               \
+    do {                                                                                                               \
+        if ((logger).isEnabled(level)) {                                                                              \
+            (logger).write(level, msg);                                                                                \
+        }                                                                                                              \
+    } while (false)
+
+// NOTE building with NEON_DISABLE_DEBUG_LOGGING removes all debug messages at compile time, the message is still type
+// checked, but never evaluated
+#if NEON_DISABLE_DEBUG_LOGGING
+#define LOG_DEBUG(logger, msg)                                                                                         \
+    do {                                                                                                               \
+        if constexpr (false) {                                                                                         \
+            (logger).write(Logger::DEBUG_, msg);                                                                       \
+        }                                                                                                              \
+    } while (false)
+#else
+#define LOG_DEBUG(logger, msg) LOG_AT_LEVEL(logger, Logger::DEBUG_, msg)
+#endif
+
+class LogBuffer;
+
+// NOTE messages are handed to a background thread that writes them in batches, call flush() before writing to stdout
+// directly, if the output has to stay in order. Warnings and errors are always flushed immediately.
 class Logger {
   public:
     enum LogLevel {
@@ -16,20 +43,33 @@ class Logger {
     };
 
     Logger();
+    ~Logger();
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
 
     inline void debug(const std::string &msg) const { log(LogLevel::DEBUG_, msg); }
     inline void info(const std::string &msg) const { log(LogLevel::INFO, msg); }
     inline void warn(const std::string &msg) const { log(LogLevel::WARNING, msg); }
     inline void error(const std::string &msg) const { log(LogLevel::ERROR, msg); }
 
+    [[nodiscard]] inline bool isEnabled(LogLevel level) const { return level >= logLevel && level != DISABLED; }
+    // prints the message without checking the log level again, use the LOG_* macros instead
+    void write(LogLevel level, const std::string &msg) const;
+    // blocks until all messages that have been logged so far are written
+    void flush() const;
+
     LogLevel getLogLevel() const { return logLevel; }
     void setLogLevel(LogLevel level) { this->logLevel = level; }
 
     void setColorEnabled(bool enabled) { this->colorEnabled = enabled; }
+    // writes one JSON object per line instead of human readable messages
+    void setJsonEnabled(bool enabled) { this->jsonEnabled = enabled; }
 
   private:
     LogLevel logLevel = LogLevel::INFO;
     bool colorEnabled = true;
+    bool jsonEnabled = false;
+    std::unique_ptr<LogBuffer> buffer;
 
     void log(const LogLevel level, const std::string& msg) const;
 };
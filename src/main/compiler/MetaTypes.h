@@ -1,23 +1,25 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "SymbolTable.h"
 #include "ast/Types.h"
 
 struct FunctionArgument {
-    std::string name;
+    Symbol name;
     ast::DataType type;
 };
 
 struct FunctionSignature {
-    std::string name;
+    Symbol name;
     ast::DataType returnType;
     std::vector<FunctionArgument> arguments = {};
 };
 
 struct ComplexTypeMember {
-    std::string name;
+    Symbol name;
     ast::DataType type;
 };
 
@@ -25,3 +27,25 @@ struct ComplexType {
     ast::DataType type;
     std::vector<ComplexTypeMember> members = {};
 };
+
+// Maps the member names of a complex type to their position, so that member accesses don't have to search the member
+// list. There is exactly one layout per complex type, which is built together with the SymbolIndex.
+struct ComplexTypeLayout {
+    const ComplexType *complexType = nullptr;
+    std::unordered_map<Symbol, int> memberIndices = {};
+
+    explicit ComplexTypeLayout(const ComplexType *complexType) : complexType(complexType) {
+        for (size_t i = 0; i < complexType->members.size(); i++) {
+            memberIndices.emplace(complexType->members[i].name, static_cast<int>(i));
+        }
+    }
+
+    // returns -1 if the type has no member with the given name
+    [[nodiscard]] int memberIndex(Symbol name) const {
+        auto itr = memberIndices.find(name);
+        if (itr == memberIndices.end()) {
+            return -1;
+        }
+        return itr->second;
+    }
+};
@@ -0,0 +1,477 @@
+#include "ModuleCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if !WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[8] = {'N', 'E', 'O', 'N', 'A', 'S', 'T', '\0'};
+
+// the file starts with this header, followed by the nodes, the lists, the strings, the names of all symbols and the
+// names of all data types
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nodeSize;
+    uint64_t sourceHash;
+    uint32_t nodeCount;
+    uint32_t listCount;
+    uint32_t stringSize;
+    uint32_t symbolCount;
+    uint32_t dataTypeCount;
+};
+
+// Maps a whole file into memory, or reads it if mapping is not possible.
+class MappedFile {
+  public:
+    explicit MappedFile(const std::filesystem::path &filePath) {
+#if !WIN32
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd != -1) {
+            struct stat fileStat = {};
+            if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+                mappedSize = static_cast<size_t>(fileStat.st_size);
+                void *data = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    mappedData = data;
+                    contents = {static_cast<const char *>(data), mappedSize};
+                }
+            }
+            close(fd);
+            if (mappedData != nullptr) {
+                return;
+            }
+        }
+#endif
+        std::ifstream infile(filePath, std::ios::binary);
+        if (!infile.good()) {
+            return;
+        }
+        readBuffer.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+        contents = readBuffer;
+    }
+    ~MappedFile() {
+#if !WIN32
+        if (mappedData != nullptr) {
+            munmap(mappedData, mappedSize);
+        }
+#endif
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    std::string_view contents = {};
+
+  private:
+    void *mappedData = nullptr;
+    size_t mappedSize = 0;
+    std::string readBuffer = {};
+};
+
+// reads the file front to back, every read fails once the end of the file has been reached
+class CacheReader {
+  public:
+    explicit CacheReader(std::string_view contents) : contents(contents) {}
+
+    const char *read(size_t size) {
+        if (contents.size() - position < size) {
+            return nullptr;
+        }
+        const auto *result = contents.data() + position;
+        position += size;
+        return result;
+    }
+
+  private:
+    std::string_view contents;
+    size_t position = 0;
+};
+
+// NOTE the names follow the strings, so their sizes are not aligned
+std::optional<std::string_view> readName(CacheReader &reader) {
+    const auto *sizeData = reader.read(sizeof(uint32_t));
+    if (sizeData == nullptr) {
+        return {};
+    }
+    uint32_t size = 0;
+    std::memcpy(&size, sizeData, sizeof(size));
+    const auto *name = reader.read(size);
+    if (name == nullptr) {
+        return {};
+    }
+    return std::string_view(name, size);
+}
+
+void writeName(std::ofstream &outfile, std::string_view name) {
+    const auto size = static_cast<uint32_t>(name.size());
+    outfile.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    outfile.write(name.data(), static_cast<std::streamsize>(size));
+}
+
+// Copies the fields of the member of the union that is used by the type of the node. The destination has to be zeroed,
+// so that the bytes that no field covers (the rest of the union and the padding) are zero as well.
+void copyActiveMember(AstNode &destination, const AstNode &source) {
+    destination.type = source.type;
+    destination.id = source.id;
+    switch (source.type) {
+    case ast::NodeType::SEQUENCE:
+        destination.sequence.children = source.sequence.children;
+        break;
+    case ast::NodeType::STATEMENT:
+        destination.statement.child = source.statement.child;
+        destination.statement.returnStatement = source.statement.returnStatement;
+        break;
+    case ast::NodeType::LITERAL:
+        destination.literal.type = source.literal.type;
+        switch (source.literal.type) {
+        case LiteralType::BOOL:
+            destination.literal.b = source.literal.b;
+            break;
+        case LiteralType::INTEGER:
+            destination.literal.i = source.literal.i;
+            break;
+        case LiteralType::FLOAT:
+            destination.literal.d = source.literal.d;
+            break;
+        case LiteralType::STRING:
+            destination.literal.s = source.literal.s;
+            break;
+        }
+        break;
+    case ast::NodeType::UNARY_OPERATION:
+        destination.unary_operation.type = source.unary_operation.type;
+        destination.unary_operation.child = source.unary_operation.child;
+        break;
+    case ast::NodeType::BINARY_OPERATION:
+        destination.binary_operation.type = source.binary_operation.type;
+        destination.binary_operation.left = source.binary_operation.left;
+        destination.binary_operation.right = source.binary_operation.right;
+        break;
+    case ast::NodeType::FUNCTION:
+        destination.function.name = source.function.name;
+        destination.function.returnType = source.function.returnType;
+        destination.function.body = source.function.body;
+        destination.function.arguments = source.function.arguments;
+        break;
+    case ast::NodeType::CALL:
+        destination.call.name = source.call.name;
+        destination.call.arguments = source.call.arguments;
+        break;
+    case ast::NodeType::VARIABLE_DEFINITION:
+        destination.variable_definition.name = source.variable_definition.name;
+        destination.variable_definition.type = source.variable_definition.type;
+        destination.variable_definition.arraySize = source.variable_definition.arraySize;
+        break;
+    case ast::NodeType::VARIABLE:
+        destination.variable.name = source.variable.name;
+        destination.variable.arrayIndex = source.variable.arrayIndex;
+        break;
+    case ast::NodeType::ASSIGNMENT:
+        destination.assignment.left = source.assignment.left;
+        destination.assignment.right = source.assignment.right;
+        break;
+    case ast::NodeType::IF_STATEMENT:
+        destination.if_statement.condition = source.if_statement.condition;
+        destination.if_statement.ifBody = source.if_statement.ifBody;
+        destination.if_statement.elseBody = source.if_statement.elseBody;
+        break;
+    case ast::NodeType::FOR_STATEMENT:
+        destination.for_statement.init = source.for_statement.init;
+        destination.for_statement.condition = source.for_statement.condition;
+        destination.for_statement.update = source.for_statement.update;
+        destination.for_statement.body = source.for_statement.body;
+        break;
+    case ast::NodeType::IMPORT:
+        destination.import.fileName = source.import.fileName;
+        break;
+    case ast::NodeType::TYPE_DECLARATION:
+        destination.type_declaration.name = source.type_declaration.name;
+        destination.type_declaration.members = source.type_declaration.members;
+        break;
+    case ast::NodeType::TYPE_MEMBER:
+        destination.type_member.variable_definition = source.type_member.variable_definition;
+        break;
+    case ast::NodeType::MEMBER_ACCESS:
+        destination.member_access.left = source.member_access.left;
+        destination.member_access.right = source.member_access.right;
+        break;
+    case ast::NodeType::ASSERT:
+        destination.assert.condition = source.assert.condition;
+        break;
+    case ast::NodeType::COMMENT:
+        destination.comment.content = source.comment.content;
+        break;
+    }
+}
+
+// The nodes of an entry are used as they are, so everything that is used as an index has to be in range. This catches
+// damaged files and layout changes that keep the size of AstNode.
+class NodeValidator {
+  public:
+    explicit NodeValidator(const CacheHeader &header) : header(header) {}
+
+    [[nodiscard]] bool isValid(const AstNode &node) const {
+        switch (node.type) {
+        case ast::NodeType::SEQUENCE:
+            return isValid(node.sequence.children);
+        case ast::NodeType::STATEMENT:
+            return isValid(node.statement.child);
+        case ast::NodeType::LITERAL:
+            switch (node.literal.type) {
+            case LiteralType::BOOL:
+            case LiteralType::INTEGER:
+            case LiteralType::FLOAT:
+                return true;
+            case LiteralType::STRING:
+                return isValid(node.literal.s);
+            }
+            return false;
+        case ast::NodeType::UNARY_OPERATION:
+            return node.unary_operation.type <= ast::UnaryOperationType::NEGATE &&
+                   isValid(node.unary_operation.child);
+        case ast::NodeType::BINARY_OPERATION:
+            return node.binary_operation.type <= ast::BinaryOperationType::OR &&
+                   isValid(node.binary_operation.left) && isValid(node.binary_operation.right);
+        case ast::NodeType::FUNCTION:
+            return isValid(node.function.body) && isValid(node.function.arguments);
+        case ast::NodeType::CALL:
+            return isValid(node.call.arguments);
+        case ast::NodeType::VARIABLE_DEFINITION:
+            return true;
+        case ast::NodeType::VARIABLE:
+            return isValid(node.variable.arrayIndex);
+        case ast::NodeType::ASSIGNMENT:
+            return isValid(node.assignment.left) && isValid(node.assignment.right);
+        case ast::NodeType::IF_STATEMENT:
+            return isValid(node.if_statement.condition) && isValid(node.if_statement.ifBody) &&
+                   isValid(node.if_statement.elseBody);
+        case ast::NodeType::FOR_STATEMENT:
+            return isValid(node.for_statement.init) && isValid(node.for_statement.condition) &&
+                   isValid(node.for_statement.update) && isValid(node.for_statement.body);
+        case ast::NodeType::IMPORT:
+            return isValid(node.import.fileName);
+        case ast::NodeType::TYPE_DECLARATION:
+            return isValid(node.type_declaration.members);
+        case ast::NodeType::TYPE_MEMBER:
+            return isValid(node.type_member.variable_definition);
+        case ast::NodeType::MEMBER_ACCESS:
+            return isValid(node.member_access.left) && isValid(node.member_access.right);
+        case ast::NodeType::ASSERT:
+            return isValid(node.assert.condition);
+        case ast::NodeType::COMMENT:
+            return isValid(node.comment.content);
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool isValid(AstNodeID id) const { return id == NO_NODE || id < header.nodeCount; }
+
+  private:
+    const CacheHeader &header;
+
+    [[nodiscard]] bool isValid(const AstList &list) const {
+        return list.offset <= header.listCount && list.count <= header.listCount - list.offset;
+    }
+    [[nodiscard]] bool isValid(const AstString &string) const {
+        return string.offset <= header.stringSize && string.size <= header.stringSize - string.offset;
+    }
+};
+
+} // namespace
+
+std::optional<uint64_t> ModuleCache::hashSource(const std::filesystem::path &filePath) {
+    MappedFile file(filePath);
+    if (file.contents.empty()) {
+        return {};
+    }
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : file.contents) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string ModuleCache::cacheFilePath(const Module *module) const {
+    return buildEnv->buildDirectory + module->getFilePath().string() + ".ast";
+}
+
+bool ModuleCache::load(Module *module, uint64_t sourceHash) {
+    const auto filePath = cacheFilePath(module);
+    if (!std::filesystem::exists(filePath)) {
+        return false;
+    }
+
+    MappedFile file(filePath);
+    CacheReader reader(file.contents);
+    const auto *header = reinterpret_cast<const CacheHeader *>(reader.read(sizeof(CacheHeader)));
+    if (header == nullptr || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header->version != FORMAT_VERSION || header->nodeSize != sizeof(AstNode) || header->sourceHash != sourceHash ||
+        header->nodeCount == 0) {
+        LOG_DEBUG(log, "Ignoring outdated cache entry " + filePath);
+        return false;
+    }
+
+    const auto *nodes = reinterpret_cast<const AstNode *>(reader.read(header->nodeCount * sizeof(AstNode)));
+    const auto *lists = reinterpret_cast<const AstNodeID *>(reader.read(header->listCount * sizeof(AstNodeID)));
+    const auto *strings = reader.read(header->stringSize);
+    if (nodes == nullptr || lists == nullptr || strings == nullptr) {
+        log.warn("Ignoring truncated cache entry " + filePath);
+        return false;
+    }
+
+    // symbols and data types are only valid for the process that created them, so the file stores the names instead
+    std::vector<Symbol> symbols = {};
+    symbols.reserve(header->symbolCount);
+    for (uint32_t i = 0; i < header->symbolCount; i++) {
+        const auto name = readName(reader);
+        if (!name) {
+            log.warn("Ignoring truncated cache entry " + filePath);
+            return false;
+        }
+        symbols.push_back(symbolTable.intern(*name));
+    }
+    std::vector<ast::DataType> dataTypes = {};
+    dataTypes.reserve(header->dataTypeCount);
+    for (uint32_t i = 0; i < header->dataTypeCount; i++) {
+        const auto name = readName(reader);
+        if (!name) {
+            log.warn("Ignoring truncated cache entry " + filePath);
+            return false;
+        }
+        dataTypes.emplace_back(*name);
+    }
+
+    const NodeValidator validator(*header);
+    for (uint32_t i = 0; i < header->listCount; i++) {
+        AstNodeID id = 0;
+        std::memcpy(&id, lists + i, sizeof(id));
+        if (!validator.isValid(id)) {
+            log.warn("Ignoring corrupt cache entry " + filePath);
+            return false;
+        }
+    }
+
+    auto tree = AST::fromData(nodes, header->nodeCount, lists, header->listCount, strings, header->stringSize);
+    for (size_t i = 0; i < tree.size(); i++) {
+        auto *node = tree.get(static_cast<AstNodeID>(i));
+        if (!validator.isValid(*node)) {
+            log.warn("Ignoring corrupt cache entry " + filePath);
+            return false;
+        }
+        auto *symbol = symbolOf(node);
+        if (symbol != nullptr) {
+            if (*symbol >= symbols.size()) {
+                log.warn("Ignoring corrupt cache entry " + filePath);
+                return false;
+            }
+            *symbol = symbols[*symbol];
+        }
+        auto *dataType = dataTypeOf(node);
+        if (dataType != nullptr) {
+            if (dataType->id >= dataTypes.size()) {
+                log.warn("Ignoring corrupt cache entry " + filePath);
+                return false;
+            }
+            *dataType = dataTypes[dataType->id];
+        }
+    }
+
+    tree.completed();
+    module->ast = tree;
+    LOG_DEBUG(log, "Loaded " + module->getFilePath().string() + " from " + filePath);
+    return true;
+}
+
+void ModuleCache::store(const Module *module, uint64_t sourceHash) {
+    const auto &tree = module->ast;
+
+    std::unordered_map<Symbol, uint32_t> localSymbols = {};
+    std::vector<Symbol> symbols = {};
+    std::unordered_map<ast::DataType, uint32_t> localDataTypes = {};
+    std::vector<ast::DataType> dataTypes = {};
+    // NOTE the buffer is zeroed first, so that the union bytes that the active member doesn't use are written as zeros
+    // instead of whatever was on the heap. That way the same source always results in the same file.
+    std::vector<AstNode> nodes(tree.size());
+    std::memset(static_cast<void *>(nodes.data()), 0, nodes.size() * sizeof(AstNode));
+    for (size_t i = 0; i < tree.size(); i++) {
+        copyActiveMember(nodes[i], *tree.get(static_cast<AstNodeID>(i)));
+        auto *symbol = symbolOf(&nodes[i]);
+        if (symbol != nullptr) {
+            auto itr = localSymbols.find(*symbol);
+            if (itr == localSymbols.end()) {
+                itr = localSymbols.emplace(*symbol, static_cast<uint32_t>(symbols.size())).first;
+                symbols.push_back(*symbol);
+            }
+            *symbol = itr->second;
+        }
+        auto *dataType = dataTypeOf(&nodes[i]);
+        if (dataType != nullptr) {
+            auto itr = localDataTypes.find(*dataType);
+            if (itr == localDataTypes.end()) {
+                itr = localDataTypes.emplace(*dataType, static_cast<uint32_t>(dataTypes.size())).first;
+                dataTypes.push_back(*dataType);
+            }
+            dataType->id = itr->second;
+        }
+    }
+
+    const auto &lists = tree.listData();
+    const auto &strings = tree.stringData();
+    CacheHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.nodeSize = sizeof(AstNode);
+    header.sourceHash = sourceHash;
+    header.nodeCount = static_cast<uint32_t>(nodes.size());
+    header.listCount = static_cast<uint32_t>(lists.size());
+    header.stringSize = static_cast<uint32_t>(strings.size());
+    header.symbolCount = static_cast<uint32_t>(symbols.size());
+    header.dataTypeCount = static_cast<uint32_t>(dataTypes.size());
+
+    // NOTE writing to a temporary file first makes sure that a build that is aborted never leaves a broken entry behind
+    const auto filePath = cacheFilePath(module);
+    const auto temporaryFilePath = filePath + ".tmp";
+    {
+        std::ofstream outfile(temporaryFilePath, std::ios::binary | std::ios::trunc);
+        if (!outfile.good()) {
+            log.warn("Could not write cache entry " + filePath);
+            return;
+        }
+        outfile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        outfile.write(reinterpret_cast<const char *>(nodes.data()),
+                      static_cast<std::streamsize>(nodes.size() * sizeof(AstNode)));
+        outfile.write(reinterpret_cast<const char *>(lists.data()),
+                      static_cast<std::streamsize>(lists.size() * sizeof(AstNodeID)));
+        outfile.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        for (const auto symbol : symbols) {
+            writeName(outfile, symbolTable.get(symbol));
+        }
+        for (const auto &dataType : dataTypes) {
+            writeName(outfile, dataType.name());
+        }
+        if (!outfile.good()) {
+            log.warn("Could not write cache entry " + filePath);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryFilePath, filePath, error);
+    if (error) {
+        log.warn("Could not write cache entry " + filePath + ": " + error.message());
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../BuildEnv.h"
+#include "../Module.h"
+#include "Logger.h"
+#include "SymbolTable.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+// Stores the parsed tree of every module in the build directory, so that unchanged modules don't have to be lexed and
+// parsed again on the next build. An entry is only used, if it has been written by the same version of the format and
+// the hash of the source file has not changed since then.
+class ModuleCache {
+  public:
+    // NOTE bump this whenever the layout of AstNode or of the file changes
+    static const uint32_t FORMAT_VERSION = 2;
+
+    ModuleCache(const BuildEnv *buildEnv, SymbolTable &symbolTable, const Logger &logger)
+        : buildEnv(buildEnv), symbolTable(symbolTable), log(logger) {}
+
+    // sets the tree of the module and returns true, if there is a valid entry for the module
+    bool load(Module *module, uint64_t sourceHash);
+    void store(const Module *module, uint64_t sourceHash);
+
+    static std::optional<uint64_t> hashSource(const std::filesystem::path &filePath);
+
+  private:
+    const BuildEnv *buildEnv;
+    SymbolTable &symbolTable;
+    const Logger &log;
+
+    [[nodiscard]] std::string cacheFilePath(const Module *module) const;
+};
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "MetaTypes.h"
+#include "ast/AstNode.h"
+#include "ast/NodeMap.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 struct ModuleCompileState {
     std::vector<std::string> imports = {};
     std::vector<FunctionSignature> functions = {};
-    std::unordered_map<AstNode*, ast::DataType> nodeToTypeMap;
-    std::unordered_map<std::string, ast::DataType> nameToTypeMap;
+    NodeMap<ast::DataType> nodeToTypeMap;
+    std::unordered_map<Symbol, ast::DataType> nameToTypeMap;
     std::vector<ComplexType> complexTypes;
 };
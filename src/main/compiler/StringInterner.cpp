@@ -0,0 +1,33 @@
+#include "StringInterner.h"
+
+#include <mutex>
+
+uint32_t StringInterner::intern(std::string_view name) {
+    {
+        std::shared_lock lock(mutex);
+        auto itr = ids.find(name);
+        if (itr != ids.end()) {
+            return itr->second;
+        }
+    }
+
+    std::unique_lock lock(mutex);
+    auto itr = ids.find(name);
+    if (itr != ids.end()) {
+        return itr->second;
+    }
+    const auto id = static_cast<uint32_t>(names.size());
+    const auto &storedName = names.emplace_back(name);
+    ids[storedName] = id;
+    return id;
+}
+
+const std::string &StringInterner::get(uint32_t id) const {
+    std::shared_lock lock(mutex);
+    return names[id];
+}
+
+size_t StringInterner::size() const {
+    std::shared_lock lock(mutex);
+    return names.size();
+}
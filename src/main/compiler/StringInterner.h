@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Hands out consecutive IDs for names, so that names can be stored and compared as integers. The same name always gets
+// the same ID. It is safe to use from multiple threads.
+class StringInterner {
+  public:
+    uint32_t intern(std::string_view name);
+    [[nodiscard]] const std::string &get(uint32_t id) const;
+    [[nodiscard]] size_t size() const;
+
+  private:
+    mutable std::shared_mutex mutex = {};
+    // a deque never moves its elements, so the views in the map and the returned names stay valid
+    std::deque<std::string> names = {};
+    std::unordered_map<std::string_view, uint32_t> ids = {};
+};
@@ -0,0 +1,60 @@
+#include "SymbolIndex.h"
+
+// NOTE emplace never replaces an existing entry, so the first declaration of a name wins
+void SymbolIndex::addDeclarations(ModuleIndex &index, Module *module, const ModuleCompileState &state) {
+    for (const auto &function : state.functions) {
+        index.functions.emplace(function.name, FunctionResolveResult{true, &function, module});
+    }
+    for (const auto &complexType : state.complexTypes) {
+        const auto *layout = &layouts.try_emplace(&complexType, &complexType).first->second;
+        index.types.emplace(complexType.type, TypeResolveResult{true, &complexType, layout, module});
+    }
+}
+
+void SymbolIndex::build(Program *program, const std::unordered_map<Module *, ModuleCompileState> &moduleCompileState) {
+    modules.clear();
+    layouts.clear();
+    for (const auto &entry : moduleCompileState) {
+        auto *module = entry.first;
+        const auto &state = entry.second;
+        auto &index = modules[module];
+        addDeclarations(index, module, state);
+
+        for (const auto &importedModuleId : state.imports) {
+            auto moduleItr = program->modules.find(importedModuleId);
+            if (moduleItr == program->modules.end()) {
+                continue;
+            }
+            auto *importedModule = moduleItr->second;
+            auto stateItr = moduleCompileState.find(importedModule);
+            if (stateItr == moduleCompileState.end()) {
+                continue;
+            }
+            addDeclarations(index, importedModule, stateItr->second);
+        }
+    }
+}
+
+FunctionResolveResult SymbolIndex::findFunction(Module *module, Symbol name) const {
+    auto moduleItr = modules.find(module);
+    if (moduleItr == modules.end()) {
+        return {};
+    }
+    auto itr = moduleItr->second.functions.find(name);
+    if (itr == moduleItr->second.functions.end()) {
+        return {};
+    }
+    return itr->second;
+}
+
+TypeResolveResult SymbolIndex::findType(Module *module, const ast::DataType &type) const {
+    auto moduleItr = modules.find(module);
+    if (moduleItr == modules.end()) {
+        return {};
+    }
+    auto itr = moduleItr->second.types.find(type);
+    if (itr == moduleItr->second.types.end()) {
+        return {};
+    }
+    return itr->second;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../Program.h"
+#include "MetaTypes.h"
+#include "ModuleCompileState.h"
+
+#include <unordered_map>
+
+struct FunctionResolveResult {
+    bool functionExists = false;
+    const FunctionSignature *signature = nullptr;
+    // TODO do we really need this?
+    Module *module = nullptr;
+};
+
+struct TypeResolveResult {
+    bool typeExists = false;
+    const ComplexType *complexType = nullptr;
+    const ComplexTypeLayout *layout = nullptr;
+    // TODO do we really need this?
+    Module *module = nullptr;
+};
+
+// Maps the names of all functions and types that are visible inside of a module to their declaration. A module sees its
+// own declarations first and then the ones of its imports, in the order in which they are imported.
+// NOTE the results point into the ModuleCompileState of the declaring module, so the declarations must not change once
+// the index has been built
+class SymbolIndex {
+  public:
+    void build(Program *program, const std::unordered_map<Module *, ModuleCompileState> &moduleCompileState);
+
+    [[nodiscard]] FunctionResolveResult findFunction(Module *module, Symbol name) const;
+    [[nodiscard]] TypeResolveResult findType(Module *module, const ast::DataType &type) const;
+
+  private:
+    struct ModuleIndex {
+        std::unordered_map<Symbol, FunctionResolveResult> functions = {};
+        std::unordered_map<ast::DataType, TypeResolveResult> types = {};
+    };
+
+    std::unordered_map<Module *, ModuleIndex> modules = {};
+    // NOTE the elements of an unordered_map never move, so the resolve results can point into it
+    std::unordered_map<const ComplexType *, ComplexTypeLayout> layouts = {};
+
+    void addDeclarations(ModuleIndex &index, Module *module, const ModuleCompileState &state);
+};
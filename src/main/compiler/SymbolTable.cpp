@@ -0,0 +1,6 @@
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable() {
+    // the empty name is always symbol 0, so that default initialized symbols are valid
+    intern("");
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "StringInterner.h"
+
+#include <cstdint>
+
+// NOTE symbols are only valid for the SymbolTable that created them, comparing two symbols is an integer compare
+typedef uint32_t Symbol;
+
+// NOTE modules are lexed in parallel, so the table is safe to use from multiple threads
+class SymbolTable : public StringInterner {
+  public:
+    SymbolTable();
+};
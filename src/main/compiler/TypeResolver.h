@@ -3,30 +3,26 @@
 #include "../Program.h"
 #include "MetaTypes.h"
 #include "ModuleCompileState.h"
+#include "SymbolIndex.h"
 #include "ast/Types.h"
 #include "ast/AstNode.h"
 
 #include <unordered_map>
 
-struct TypeResolveResult {
-    bool typeExists = false;
-    ComplexType complexType = {ast::DataType()};
-    // TODO do we really need this?
-    Module *module = nullptr;
-};
-
+// NOTE the resolver only reads the compile state, so it can be shared by all threads once the types have been analysed
 class TypeResolver {
   public:
-    explicit TypeResolver(Program *program, std::unordered_map<Module *, ModuleCompileState> &moduleCompileState)
-        : program(program), moduleCompileState(moduleCompileState) {}
+    explicit TypeResolver(const SymbolIndex &symbolIndex,
+                          const std::unordered_map<Module *, ModuleCompileState> &moduleCompileState)
+        : symbolIndex(symbolIndex), moduleCompileState(moduleCompileState) {}
 
-    ast::DataType getTypeOf(Module *module, AstNode* node);
-    ast::DataType getTypeOf(Module *module, const std::string &variableName);
+    ast::DataType getTypeOf(Module *module, AstNode* node) const;
+    ast::DataType getTypeOf(Module *module, Symbol variableName) const;
 
     TypeResolveResult resolveType(Module *module, const ast::DataType &type) const;
 
   private:
-    Program *program;
+    const SymbolIndex &symbolIndex;
 
-    std::unordered_map<Module *, ModuleCompileState> &moduleCompileState;
+    const std::unordered_map<Module *, ModuleCompileState> &moduleCompileState;
 };
@@ -1,27 +1,133 @@
 #include "AST.h"
 
-#include <cassert>
-#include <iostream>
 #include <utility>
 
-AST::AST() {
-    size_t size = nodeCapacity * sizeof(AstNode);
-    buffer = (AstNode *)std::malloc(size);
+namespace {
+
+template <typename T> AstNodeID idOf(T *node) { return node == nullptr ? NO_NODE : AST_NODE(node)->id; }
+
+void relocate(AstNodeID &id, AstNodeID offset) {
+    if (id != NO_NODE) {
+        id += offset;
+    }
 }
 
-AstNode *AST::root() {
-    // NOTE: the first node in the buffer is assumed to be the root node
-    return buffer;
+} // namespace
+
+AST::AST() : arena(std::make_shared<AstArena>()) { createNode<SequenceNode>(ast::NodeType::SEQUENCE); }
+
+AstNode *AST::root() { return arena->get(ROOT_ID); }
+
+AstNodeID AST::append(const AST &other) { return append(other, ROOT_ID, static_cast<AstNodeID>(other.size())); }
+
+AstNodeID AST::append(const AST &other, AstNodeID begin, AstNodeID end) {
+    // NOTE the offset wraps around, if the nodes are copied to smaller IDs, which the unsigned additions undo again
+    const auto offset = static_cast<AstNodeID>(arena->size()) - begin;
+    const auto &source = *other.arena;
+    const auto copyList = [this, &source, offset](AstList &list) {
+        std::vector<AstNodeID> ids(source.list(list), source.list(list) + list.count);
+        for (auto &id : ids) {
+            id += offset;
+        }
+        list = arena->storeList(ids.data(), ids.size());
+    };
+    const auto copyString = [this, &source](AstString &str) { str = arena->storeString(source.string(str)); };
+
+    for (AstNodeID i = begin; i < end; i++) {
+        auto *node = arena->allocate();
+        const auto id = node->id;
+        *node = *source.get(i);
+        node->id = id;
+
+        switch (node->type) {
+        case ast::NodeType::ASSERT:
+            relocate(node->assert.condition, offset);
+            break;
+        case ast::NodeType::ASSIGNMENT:
+            relocate(node->assignment.left, offset);
+            relocate(node->assignment.right, offset);
+            break;
+        case ast::NodeType::BINARY_OPERATION:
+            relocate(node->binary_operation.left, offset);
+            relocate(node->binary_operation.right, offset);
+            break;
+        case ast::NodeType::CALL:
+            copyList(node->call.arguments);
+            break;
+        case ast::NodeType::COMMENT:
+            copyString(node->comment.content);
+            break;
+        case ast::NodeType::FOR_STATEMENT:
+            relocate(node->for_statement.init, offset);
+            relocate(node->for_statement.condition, offset);
+            relocate(node->for_statement.update, offset);
+            relocate(node->for_statement.body, offset);
+            break;
+        case ast::NodeType::FUNCTION:
+            relocate(node->function.body, offset);
+            copyList(node->function.arguments);
+            break;
+        case ast::NodeType::IF_STATEMENT:
+            relocate(node->if_statement.condition, offset);
+            relocate(node->if_statement.ifBody, offset);
+            relocate(node->if_statement.elseBody, offset);
+            break;
+        case ast::NodeType::IMPORT:
+            copyString(node->import.fileName);
+            break;
+        case ast::NodeType::LITERAL:
+            if (node->literal.type == LiteralType::STRING) {
+                copyString(node->literal.s);
+            }
+            break;
+        case ast::NodeType::MEMBER_ACCESS:
+            relocate(node->member_access.left, offset);
+            relocate(node->member_access.right, offset);
+            break;
+        case ast::NodeType::SEQUENCE:
+            copyList(node->sequence.children);
+            break;
+        case ast::NodeType::STATEMENT:
+            relocate(node->statement.child, offset);
+            break;
+        case ast::NodeType::TYPE_DECLARATION:
+            copyList(node->type_declaration.members);
+            break;
+        case ast::NodeType::TYPE_MEMBER:
+            relocate(node->type_member.variable_definition, offset);
+            break;
+        case ast::NodeType::UNARY_OPERATION:
+            relocate(node->unary_operation.child, offset);
+            break;
+        case ast::NodeType::VARIABLE:
+            relocate(node->variable.arrayIndex, offset);
+            break;
+        case ast::NodeType::VARIABLE_DEFINITION:
+            // a variable definition doesn't link to other nodes
+            break;
+        }
+    }
+    return offset;
 }
 
-template <typename T> T *AST::createNode(ast::NodeType type) {
-    assert(nextNodeID < nodeCapacity);
-    if (nextNodeID >= nodeCapacity) {
-        std::cerr << "Ran out of space for ast nodes!" << std::endl;
+AstArenaStatistics AST::arenaStatistics() const { return arena->statistics(); }
+
+AST AST::fromData(const AstNode *nodes, size_t nodeCount, const AstNodeID *lists, size_t listCount,
+                  const char *strings, size_t stringSize) {
+    AST result = {};
+    for (size_t i = 0; i < nodeCount; i++) {
+        // NOTE the constructor already created the root node, which gets replaced by the first node
+        auto *node = i == ROOT_ID ? result.root() : result.arena->allocate();
+        *node = nodes[i];
+        node->id = static_cast<AstNodeID>(i);
     }
+    result.arena->appendListData(lists, listCount);
+    result.arena->appendStringData(strings, stringSize);
+    return result;
+}
 
-    auto node = buffer + nextNodeID;
-    nextNodeID++;
+template <typename T> T *AST::createNode(ast::NodeType type) {
+    auto node = arena->allocate();
     node->type = type;
 
     auto *result = reinterpret_cast<T *>(node);
@@ -30,28 +136,28 @@ template <typename T> T *AST::createNode(ast::NodeType type) {
 
 AssertNode *AST::createAssert(AstNode *condition) {
     auto node = createNode<AssertNode>(ast::NodeType::ASSERT);
-    node->condition = condition;
+    node->condition = idOf(condition);
     return node;
 }
 
 AssignmentNode *AST::createAssignment(AstNode *left, AstNode *right) {
     auto node = createNode<AssignmentNode>(ast::NodeType::ASSIGNMENT);
-    node->left = left;
-    node->right = right;
+    node->left = idOf(left);
+    node->right = idOf(right);
     return node;
 }
 
 BinaryOperationNode *AST::createBinaryOperation(ast::BinaryOperationType type, AstNode *left, AstNode *right) {
     auto node = createNode<BinaryOperationNode>(ast::NodeType::BINARY_OPERATION);
     node->type = type;
-    node->left = left;
-    node->right = right;
+    node->left = idOf(left);
+    node->right = idOf(right);
     return node;
 }
 
 StatementNode *AST::createStatement(AstNode *child, bool isReturn) {
     auto node = createNode<StatementNode>(ast::NodeType::STATEMENT);
-    node->child = child;
+    node->child = idOf(child);
     node->returnStatement = isReturn;
     return node;
 }
@@ -59,81 +165,81 @@ StatementNode *AST::createStatement(AstNode *child, bool isReturn) {
 UnaryOperationNode *AST::createUnaryOperation(ast::UnaryOperationType type, AstNode *child) {
     auto node = createNode<UnaryOperationNode>(ast::NodeType::UNARY_OPERATION);
     node->type = type;
-    node->child = child;
+    node->child = idOf(child);
     return node;
 }
 
-CallNode *AST::createCall(std::string name, std::vector<AstNode *> parameters) {
+CallNode *AST::createCall(Symbol name, const std::vector<AstNode *> &parameters) {
     auto node = createNode<CallNode>(ast::NodeType::CALL);
-    node->name = std::move(name);
-    node->arguments = std::move(parameters);
+    node->name = name;
+    node->arguments = createList(parameters);
     return node;
 }
 
-FunctionNode *AST::createFunction(std::string name, ast::DataType returnType,
-                                  std::vector<VariableDefinitionNode *> parameters, SequenceNode *body) {
+FunctionNode *AST::createFunction(Symbol name, const ast::DataType &returnType,
+                                  const std::vector<VariableDefinitionNode *> &parameters, SequenceNode *body) {
     auto node = createNode<FunctionNode>(ast::NodeType::FUNCTION);
-    node->name = std::move(name);
-    node->returnType = std::move(returnType);
-    node->arguments = std::move(parameters);
-    node->body = AST_NODE(body);
+    node->name = name;
+    node->returnType = returnType;
+    node->arguments = createList(parameters);
+    node->body = idOf(body);
     return node;
 }
 
 IfStatementNode *AST::createIf(AstNode *condition, SequenceNode *ifBody, SequenceNode *elseBody) {
     auto node = createNode<IfStatementNode>(ast::NodeType::IF_STATEMENT);
-    node->condition = condition;
-    node->ifBody = AST_NODE(ifBody);
-    node->elseBody = AST_NODE(elseBody);
+    node->condition = idOf(condition);
+    node->ifBody = idOf(ifBody);
+    node->elseBody = idOf(elseBody);
     return node;
 }
 
 ForStatementNode *AST::createFor(StatementNode *init, AstNode *condition, StatementNode *update, SequenceNode *body) {
     auto node = createNode<ForStatementNode>(ast::NodeType::FOR_STATEMENT);
-    node->init = AST_NODE(init);
-    node->condition = condition;
-    node->update = AST_NODE(update);
-    node->body = AST_NODE(body);
+    node->init = idOf(init);
+    node->condition = idOf(condition);
+    node->update = idOf(update);
+    node->body = idOf(body);
     return node;
 }
 
-CommentNode *AST::createComment(std::string content) {
+CommentNode *AST::createComment(std::string_view content) {
     auto node = createNode<CommentNode>(ast::NodeType::COMMENT);
-    node->content = std::move(content);
+    node->content = arena->storeString(content);
     return node;
 }
 
-VariableNode *AST::createVariable(std::string name, AstNode *arrayIndex) {
+VariableNode *AST::createVariable(Symbol name, AstNode *arrayIndex) {
     auto node = createNode<VariableNode>(ast::NodeType::VARIABLE);
-    node->name = std::move(name);
-    node->arrayIndex = arrayIndex;
+    node->name = name;
+    node->arrayIndex = idOf(arrayIndex);
     return node;
 }
 
-ImportNode *AST::createImport(std::string fileName) {
+ImportNode *AST::createImport(std::string_view fileName) {
     auto node = createNode<ImportNode>(ast::NodeType::IMPORT);
-    node->fileName = std::move(fileName);
+    node->fileName = arena->storeString(fileName);
     return node;
 }
 
-VariableDefinitionNode *AST::createVariableDefinition(std::string name, ast::DataType type, int64_t arraySize) {
+VariableDefinitionNode *AST::createVariableDefinition(Symbol name, const ast::DataType &type, int64_t arraySize) {
     auto node = createNode<VariableDefinitionNode>(ast::NodeType::VARIABLE_DEFINITION);
-    node->name = std::move(name);
-    node->type = std::move(type);
+    node->name = name;
+    node->type = type;
     node->arraySize = arraySize;
     return node;
 }
 
-SequenceNode *AST::createSequence(std::vector<AstNode *> children) {
+SequenceNode *AST::createSequence(const std::vector<AstNode *> &children) {
     auto node = createNode<SequenceNode>(ast::NodeType::SEQUENCE);
-    node->children = std::move(children);
+    node->children = createList(children);
     return node;
 }
 
 MemberAccessNode *AST::createMemberAccess(AstNode *left, AstNode *right) {
     auto node = createNode<MemberAccessNode>(ast::NodeType::MEMBER_ACCESS);
-    node->left = left;
-    node->right = right;
+    node->left = idOf(left);
+    node->right = idOf(right);
     return node;
 }
 
@@ -151,12 +257,10 @@ LiteralNode *AST::createLiteralInteger(int64_t value) {
     return node;
 }
 
-LiteralNode *AST::createLiteralString(std::string value) {
+LiteralNode *AST::createLiteralString(std::string_view value) {
     auto node = createNode<LiteralNode>(ast::NodeType::LITERAL);
     node->type = LiteralType::STRING;
-    // NOTE we have to do this, in order for std::string to be initialized correctly
-    new (&node->s) std::string;
-    node->s = std::move(value);
+    node->s = arena->storeString(value);
     return node;
 }
 
@@ -169,14 +273,14 @@ LiteralNode *AST::createLiteralBool(bool value) {
 
 TypeMemberNode *AST::createTypeMember(VariableDefinitionNode *inner) {
     auto node = createNode<TypeMemberNode>(ast::NodeType::TYPE_MEMBER);
-    node->variable_definition = inner;
+    node->variable_definition = idOf(inner);
     return node;
 }
 
-TypeDeclarationNode *AST::createTypeDeclaration(std::string name, std::vector<TypeMemberNode *> members) {
+TypeDeclarationNode *AST::createTypeDeclaration(Symbol name, const std::vector<TypeMemberNode *> &members) {
     auto node = createNode<TypeDeclarationNode>(ast::NodeType::TYPE_DECLARATION);
-    node->name = std::move(name);
-    node->members = std::move(members);
+    node->name = name;
+    node->members = createList(members);
     return node;
 }
 
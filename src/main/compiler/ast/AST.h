@@ -1,34 +1,101 @@
 #pragma once
 
+#include "AstArena.h"
 #include "AstNode.h"
 
+#include <memory>
+#include <string_view>
+
+// Iterates over the nodes of an AstList.
+class AstNodeRange {
+    const AstArena *arena;
+    const AstNodeID *ids;
+    uint32_t count;
+
+  public:
+    class Iterator {
+        const AstArena *arena;
+        const AstNodeID *current;
+
+      public:
+        Iterator(const AstArena *arena, const AstNodeID *current) : arena(arena), current(current) {}
+        AstNode *operator*() const { return arena->get(*current); }
+        Iterator &operator++() {
+            current++;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return current != other.current; }
+    };
+
+    AstNodeRange(const AstArena *arena, const AstNodeID *ids, uint32_t count) : arena(arena), ids(ids), count(count) {}
+
+    [[nodiscard]] Iterator begin() const { return {arena, ids}; }
+    [[nodiscard]] Iterator end() const { return {arena, ids + count}; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    AstNode *operator[](size_t index) const { return arena->get(ids[index]); }
+    AstNode *back() const { return arena->get(ids[count - 1]); }
+};
+
+// NOTE copies of a tree share its nodes, they are freed together with the last copy
 class AST {
-    AstNode *buffer = nullptr;
-    int64_t nextNodeID = 1;
-    uint64_t nodeCapacity = 1000000;
+    std::shared_ptr<AstArena> arena;
     bool complete = false;
 
   public:
+    // the root node always has the first ID
+    static constexpr AstNodeID ROOT_ID = 0;
+
     AST();
 
     AstNode *root();
     void completed();
 
+    // returns nullptr for NO_NODE
+    [[nodiscard]] AstNode *get(AstNodeID id) const { return id == NO_NODE ? nullptr : arena->get(id); }
+    [[nodiscard]] size_t size() const { return arena->size(); }
+    [[nodiscard]] AstNodeRange nodes(AstList list) const { return {arena.get(), arena->list(list), list.count}; }
+    // NOTE the view is only valid until the next string is added to the tree
+    [[nodiscard]] std::string_view string(AstString str) const { return arena->string(str); }
+
+    // copies all nodes of other into this tree, the node with ID i in other gets the ID i + the returned offset
+    AstNodeID append(const AST &other);
+    // copies the nodes with IDs in [begin, end), which must only link to each other
+    AstNodeID append(const AST &other, AstNodeID begin, AstNodeID end);
+    [[nodiscard]] AstArenaStatistics arenaStatistics() const;
+
+    // access to the raw data of the tree, which can be written to disk as is, since it does not contain any pointers
+    [[nodiscard]] const std::vector<AstNodeID> &listData() const { return arena->listData(); }
+    [[nodiscard]] const std::vector<char> &stringData() const { return arena->stringData(); }
+    // creates a tree from raw data, that has been written out before, the first node has to be the root
+    static AST fromData(const AstNode *nodes, size_t nodeCount, const AstNodeID *lists, size_t listCount,
+                        const char *strings, size_t stringSize);
+
+    // stores the IDs of the nodes in the arena of this tree
+    template <typename T> AstList createList(const std::vector<T *> &nodes) {
+        std::vector<AstNodeID> ids = {};
+        ids.reserve(nodes.size());
+        for (auto *node : nodes) {
+            ids.push_back(AST_NODE(node)->id);
+        }
+        return arena->storeList(ids.data(), ids.size());
+    }
+
     StatementNode *createStatement(AstNode *child, bool isReturn);
     AssertNode *createAssert(AstNode *condition);
     AssignmentNode *createAssignment(AstNode *left, AstNode *right);
     BinaryOperationNode *createBinaryOperation(ast::BinaryOperationType type, AstNode *left, AstNode *right);
     UnaryOperationNode *createUnaryOperation(ast::UnaryOperationType type, AstNode *child);
-    CallNode *createCall(std::string name, std::vector<AstNode *> parameters);
-    FunctionNode *createFunction(std::string name, ast::DataType returnType,
-                                 std::vector<VariableDefinitionNode *> parameters, SequenceNode *body);
+    CallNode *createCall(Symbol name, const std::vector<AstNode *> &parameters);
+    FunctionNode *createFunction(Symbol name, const ast::DataType &returnType,
+                                 const std::vector<VariableDefinitionNode *> &parameters, SequenceNode *body);
     IfStatementNode *createIf(AstNode *condition, SequenceNode *ifBody, SequenceNode *elseBody);
     ForStatementNode *createFor(StatementNode *init, AstNode *condition, StatementNode *update, SequenceNode *body);
-    CommentNode *createComment(std::string content);
-    VariableNode *createVariable(std::string name, AstNode *arrayIndex);
-    ImportNode *createImport(std::string fileName);
-    VariableDefinitionNode *createVariableDefinition(std::string name, ast::DataType type, int64_t arraySize);
-    SequenceNode *createSequence(std::vector<AstNode *> children);
+    CommentNode *createComment(std::string_view content);
+    VariableNode *createVariable(Symbol name, AstNode *arrayIndex);
+    ImportNode *createImport(std::string_view fileName);
+    VariableDefinitionNode *createVariableDefinition(Symbol name, const ast::DataType &type, int64_t arraySize);
+    SequenceNode *createSequence(const std::vector<AstNode *> &children);
     MemberAccessNode *createMemberAccess(AstNode *left, AstNode *right);
 
     LiteralNode *createLiteralInteger(int64_t value);
@@ -37,11 +104,11 @@ class AST {
 
     LiteralNode *createLiteralBool(bool value);
 
-    LiteralNode *createLiteralString(std::string value);
+    LiteralNode *createLiteralString(std::string_view value);
 
     TypeMemberNode *createTypeMember(VariableDefinitionNode *inner);
 
-    TypeDeclarationNode *createTypeDeclaration(std::string name, std::vector<TypeMemberNode *> members);
+    TypeDeclarationNode *createTypeDeclaration(Symbol name, const std::vector<TypeMemberNode *> &members);
 
     bool is_complete() const;
 
@@ -0,0 +1,58 @@
+#include "AstArena.h"
+
+#include <cstdlib>
+#include <iostream>
+
+AstArena::~AstArena() {
+    for (auto *chunk : nodeChunks) {
+        std::free(chunk);
+    }
+}
+
+void AstArena::addNodeChunk() {
+    const auto size = nodeChunkSize == 0 ? INITIAL_NODE_CHUNK_SIZE : nodeChunkSize * 2;
+    if (nodeCount + size > NO_NODE) {
+        std::cerr << "Ran out of IDs for ast nodes!" << std::endl;
+        exit(1);
+    }
+    auto *memory = static_cast<AstNode *>(std::malloc(size * sizeof(AstNode)));
+    if (memory == nullptr) {
+        std::cerr << "Ran out of space for ast nodes!" << std::endl;
+        exit(1);
+    }
+    nodeChunks.push_back(memory);
+    currentNodeChunk = memory;
+    nodeChunkSize = size;
+    usedNodes = 0;
+}
+
+AstList AstArena::storeList(const AstNodeID *ids, size_t count) {
+    if (count == 0) {
+        return {};
+    }
+    AstList result = {static_cast<uint32_t>(lists.size()), static_cast<uint32_t>(count)};
+    lists.insert(lists.end(), ids, ids + count);
+    return result;
+}
+
+AstString AstArena::storeString(std::string_view str) {
+    if (str.empty()) {
+        return {};
+    }
+    AstString result = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size())};
+    strings.insert(strings.end(), str.begin(), str.end());
+    return result;
+}
+
+AstArenaStatistics AstArena::statistics() const {
+    AstArenaStatistics result = {};
+    result.nodeCount = nodeCount;
+    result.dataBytes = lists.size() * sizeof(AstNodeID) + strings.size();
+    result.chunkCount = nodeChunks.size();
+    for (size_t i = 0; i < nodeChunks.size(); i++) {
+        result.nodeCapacity += INITIAL_NODE_CHUNK_SIZE << i;
+    }
+    result.bytesReserved =
+          result.nodeCapacity * sizeof(AstNode) + lists.capacity() * sizeof(AstNodeID) + strings.capacity();
+    return result;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "AstNode.h"
+
+#include <bit>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+struct AstArenaStatistics {
+    size_t nodeCount = 0;
+    // number of nodes that fit into all node chunks together
+    size_t nodeCapacity = 0;
+    // bytes used by lists and strings
+    size_t dataBytes = 0;
+    size_t chunkCount = 0;
+    size_t bytesReserved = 0;
+};
+
+// Hands out AstNodes from chunks of memory. The first chunk is small, every following one is twice as large as the one
+// before, which makes it cheap to find a node by its ID. Nodes never move and are all freed together with the arena.
+// Lists and strings are addressed by their offset, so they are stored in buffers that simply grow as needed.
+class AstArena {
+  public:
+    AstArena() = default;
+    ~AstArena();
+    AstArena(const AstArena &) = delete;
+    AstArena &operator=(const AstArena &) = delete;
+
+    // NOTE the node is uninitialized except for its ID, the caller has to construct the member of the union that
+    // matches its type
+    AstNode *allocate() {
+        if (usedNodes == nodeChunkSize) {
+            addNodeChunk();
+        }
+        auto *node = currentNodeChunk + usedNodes++;
+        node->id = static_cast<AstNodeID>(nodeCount++);
+        return node;
+    }
+
+    [[nodiscard]] AstNode *get(AstNodeID id) const {
+        // NOTE chunk k starts at ID INITIAL_NODE_CHUNK_SIZE * (2^k - 1), so the highest bit of
+        // id + INITIAL_NODE_CHUNK_SIZE selects the chunk and the remaining bits are the index inside of it
+        const auto position = static_cast<size_t>(id) + INITIAL_NODE_CHUNK_SIZE;
+        const auto chunkIdx = std::bit_width(position) - std::bit_width(INITIAL_NODE_CHUNK_SIZE);
+        return nodeChunks[chunkIdx] + (position - std::bit_floor(position));
+    }
+
+    [[nodiscard]] size_t size() const { return nodeCount; }
+
+    AstList storeList(const AstNodeID *ids, size_t count);
+    [[nodiscard]] const AstNodeID *list(AstList list) const { return lists.data() + list.offset; }
+
+    AstString storeString(std::string_view str);
+    [[nodiscard]] std::string_view string(AstString str) const { return {strings.data() + str.offset, str.size}; }
+
+    // the raw lists and strings, which are relocatable just like the nodes
+    [[nodiscard]] const std::vector<AstNodeID> &listData() const { return lists; }
+    [[nodiscard]] const std::vector<char> &stringData() const { return strings; }
+    void appendListData(const AstNodeID *ids, size_t count) { lists.insert(lists.end(), ids, ids + count); }
+    void appendStringData(const char *data, size_t size) { strings.insert(strings.end(), data, data + size); }
+
+    [[nodiscard]] AstArenaStatistics statistics() const;
+
+  private:
+    static constexpr size_t INITIAL_NODE_CHUNK_SIZE = 256;
+
+    std::vector<AstNode *> nodeChunks = {};
+    AstNode *currentNodeChunk = nullptr;
+    size_t nodeChunkSize = 0;
+    size_t usedNodes = 0;
+    size_t nodeCount = 0;
+
+    std::vector<AstNodeID> lists = {};
+    std::vector<char> strings = {};
+
+    void addNodeChunk();
+};
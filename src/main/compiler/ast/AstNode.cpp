@@ -1,5 +1,7 @@
 #include "AstNode.h"
 
+#include "AST.h"
+
 #include <iostream>
 
 std::string to_string(ast::NodeType type) {
@@ -47,9 +49,9 @@ std::string to_string(ast::NodeType type) {
     }
 }
 
-std::vector<VariableNode *> MemberAccessNode::linearize_access_tree() {
+std::vector<VariableNode *> MemberAccessNode::linearize_access_tree(const AST &tree) const {
     std::vector<VariableNode *> variables = {};
-    std::vector<AstNode *> stack = {right, left};
+    std::vector<AstNode *> stack = {tree.get(right), tree.get(left)};
     while (!stack.empty()) {
         auto *current = stack.back();
         stack.pop_back();
@@ -59,8 +61,8 @@ std::vector<VariableNode *> MemberAccessNode::linearize_access_tree() {
         }
         if (current->type == ast::NodeType::MEMBER_ACCESS) {
             auto *ma = reinterpret_cast<MemberAccessNode *>(current);
-            stack.push_back(ma->right);
-            stack.push_back(ma->left);
+            stack.push_back(tree.get(ma->right));
+            stack.push_back(tree.get(ma->left));
         } else {
             // empty return value signals an error
             return {};
@@ -101,6 +103,34 @@ std::string BinaryOperationNode::operation_string() {
 
 std::string to_string(AstNode *node) { return "not implemented"; }
 
-bool VariableNode::is_array_access() const { return arrayIndex != nullptr; }
+Symbol *symbolOf(AstNode *node) {
+    switch (node->type) {
+    case ast::NodeType::CALL:
+        return &node->call.name;
+    case ast::NodeType::FUNCTION:
+        return &node->function.name;
+    case ast::NodeType::TYPE_DECLARATION:
+        return &node->type_declaration.name;
+    case ast::NodeType::VARIABLE_DEFINITION:
+        return &node->variable_definition.name;
+    case ast::NodeType::VARIABLE:
+        return &node->variable.name;
+    default:
+        return nullptr;
+    }
+}
+
+ast::DataType *dataTypeOf(AstNode *node) {
+    switch (node->type) {
+    case ast::NodeType::FUNCTION:
+        return &node->function.returnType;
+    case ast::NodeType::VARIABLE_DEFINITION:
+        return &node->variable_definition.type;
+    default:
+        return nullptr;
+    }
+}
+
+bool VariableNode::is_array_access() const { return arrayIndex != NO_NODE; }
 
 bool VariableDefinitionNode::is_array() const { return arraySize > 0; }
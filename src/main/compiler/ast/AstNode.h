@@ -1,66 +1,88 @@
 #pragma once
 
+#include "../SymbolTable.h"
 #include "Types.h"
+#include <cstdint>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #define AST_NODE(n) reinterpret_cast<AstNode *>(n)
 
 struct AstNode;
-typedef int64_t AstNodeID;
+class AST;
+// NOTE nodes refer to each other by their index in the arena of the tree, instead of by pointer. That way a link only
+// takes half the space and the nodes can be moved or written to disk without fixing up any addresses.
+typedef uint32_t AstNodeID;
+const AstNodeID NO_NODE = UINT32_MAX;
 enum class LiteralType { BOOL, INTEGER, FLOAT, STRING };
 
+// A list of node IDs, stored in the arena of the tree just like the node that contains it. Use AST::nodes to iterate
+// over it.
+struct AstList {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+};
+
+// A string, stored in the arena of the tree. Use AST::string to read it.
+struct AstString {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
 struct AssertNode {
-    AstNode *condition = nullptr;
+    AstNodeID condition = NO_NODE;
 };
 
 struct AssignmentNode {
-    AstNode *left = nullptr;
-    AstNode *right = nullptr;
+    AstNodeID left = NO_NODE;
+    AstNodeID right = NO_NODE;
 };
 
 struct BinaryOperationNode {
     ast::BinaryOperationType type;
-    AstNode *left = nullptr;
-    AstNode *right = nullptr;
+    AstNodeID left = NO_NODE;
+    AstNodeID right = NO_NODE;
 
     std::string operation_string();
 };
 
 struct CallNode {
-    std::string name;
-    std::vector<AstNode *> arguments = {};
+    Symbol name;
+    AstList arguments = {};
 };
 
 struct CommentNode {
-    std::string content;
+    AstString content;
 };
 
 struct ForStatementNode {
-    AstNode *init = nullptr;
-    AstNode *condition = nullptr;
-    AstNode *update = nullptr;
-    AstNode *body = nullptr;
+    AstNodeID init = NO_NODE;
+    AstNodeID condition = NO_NODE;
+    AstNodeID update = NO_NODE;
+    AstNodeID body = NO_NODE;
 };
 
-struct VariableDefinitionNode;
 struct FunctionNode {
-    std::string name;
+    Symbol name;
     ast::DataType returnType;
-    AstNode *body = nullptr;
-    std::vector<VariableDefinitionNode *> arguments = {};
+    AstNodeID body = NO_NODE;
+    AstList arguments = {};
 
-    [[nodiscard]] bool is_external() const { return body == nullptr; }
+    [[nodiscard]] bool is_external() const { return body == NO_NODE; }
 };
 
 struct IfStatementNode {
-    AstNode *condition = nullptr;
-    AstNode *ifBody = nullptr;
-    AstNode *elseBody = nullptr;
+    AstNodeID condition = NO_NODE;
+    AstNodeID ifBody = NO_NODE;
+    AstNodeID elseBody = NO_NODE;
 };
 
 struct ImportNode {
-    std::string fileName;
+    AstString fileName;
 };
 
 struct LiteralNode {
@@ -71,53 +93,51 @@ struct LiteralNode {
         bool b;
         int64_t i;
         double d;
-        std::string s;
+        AstString s;
     };
 };
 
 struct VariableNode;
 struct MemberAccessNode {
-    AstNode *left = nullptr;
-    AstNode *right = nullptr;
+    AstNodeID left = NO_NODE;
+    AstNodeID right = NO_NODE;
 
-    std::vector<VariableNode *> linearize_access_tree();
+    std::vector<VariableNode *> linearize_access_tree(const AST &tree) const;
 };
 
 struct SequenceNode {
-    std::vector<AstNode *> children;
+    AstList children = {};
 };
 
 struct StatementNode {
-    AstNode *child = nullptr;
+    AstNodeID child = NO_NODE;
     bool returnStatement;
 };
 
 struct TypeMemberNode {
-    VariableDefinitionNode *variable_definition = nullptr;
+    AstNodeID variable_definition = NO_NODE;
 };
 
 struct TypeDeclarationNode {
-    std::string name;
-    std::vector<TypeMemberNode *> members = {};
-
-    [[nodiscard]] ast::DataType type() const { return ast::DataType(name); }
+    Symbol name;
+    AstList members = {};
 };
 
 struct UnaryOperationNode {
     ast::UnaryOperationType type;
-    AstNode *child = nullptr;
+    AstNodeID child = NO_NODE;
 };
 
 struct VariableDefinitionNode {
-    std::string name;
+    Symbol name;
     ast::DataType type;
     int64_t arraySize;
     bool is_array() const;
 };
 
 struct VariableNode {
-    std::string name;
-    AstNode *arrayIndex = nullptr;
+    Symbol name;
+    AstNodeID arrayIndex = NO_NODE;
 
     [[nodiscard]] bool is_array_access() const;
 };
@@ -125,7 +145,6 @@ struct VariableNode {
 struct AstNode {
 
     AstNode() {}
-    ~AstNode() {}
 
     union {
         AssertNode assert;
@@ -149,7 +168,17 @@ struct AstNode {
     };
 
     ast::NodeType type;
+    // the index of this node in the arena of its tree
+    AstNodeID id;
 };
 
+// nodes are copied and freed in bulk, without ever running a constructor or destructor
+static_assert(std::is_trivially_copyable_v<AstNode>);
+static_assert(std::is_trivially_destructible_v<AstNode>);
+
 std::string to_string(ast::NodeType type);
 std::string to_string(AstNode *node);
+// returns the name of the node, or nullptr if the type of the node doesn't have one
+Symbol *symbolOf(AstNode *node);
+// returns the declared type of the node, or nullptr if the type of the node doesn't declare one
+ast::DataType *dataTypeOf(AstNode *node);
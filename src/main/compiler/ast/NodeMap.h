@@ -0,0 +1,26 @@
+#pragma once
+
+#include "AstNode.h"
+
+#include <vector>
+
+// Stores one value for every node of a tree. The value of a node is found at the index of the node's ID, so a lookup
+// never hashes and an entry takes no more space than the value itself.
+// NOTE all nodes have to belong to the same tree, nodes without an assigned value have a default constructed value
+template <typename T> class NodeMap {
+  public:
+    NodeMap() = default;
+    explicit NodeMap(size_t nodeCount) : values(nodeCount) {}
+
+    T &operator[](const AstNode *node) {
+        if (node->id >= values.size()) {
+            values.resize(node->id + 1);
+        }
+        return values[node->id];
+    }
+
+    [[nodiscard]] T get(const AstNode *node) const { return node->id < values.size() ? values[node->id] : T(); }
+
+  private:
+    std::vector<T> values = {};
+};
@@ -1,8 +1,37 @@
 #include "Types.h"
 
+#include "../StringInterner.h"
+
 #include <iostream>
 
-std::string to_string(const ast::DataType &dataType) { return dataType.typeName; }
+namespace {
+
+// NOTE the table belongs to the process and not to a Program, so that data types can be created, compared and printed
+// without passing a table around. Nothing is ever removed, but it only grows by the type names that are new to the
+// process, and the module cache maps its stored type names back to IDs on load.
+struct TypeTable : public StringInterner {
+    TypeTable() {
+        // the simple types are added first, so that their IDs are the values of SimpleDataType
+        for (const auto simple : {ast::VOID, ast::BOOLEAN, ast::INTEGER, ast::FLOAT, ast::STRING}) {
+            intern(to_string(simple));
+        }
+    }
+};
+
+TypeTable &typeTable() {
+    static TypeTable table = {};
+    return table;
+}
+
+} // namespace
+
+ast::DataType::DataType(std::string_view typeName) : id(typeTable().intern(typeName)) {}
+
+const std::string &ast::DataType::name() const { return typeTable().get(id); }
+
+size_t ast::dataTypeCount() { return typeTable().size(); }
+
+std::string to_string(const ast::DataType &dataType) { return dataType.name(); }
 
 std::string to_string(ast::SimpleDataType type) {
     switch (type) {
@@ -62,7 +91,7 @@ std::string to_string(ast::UnaryOperationType operationType) {
     exit(1);
 }
 
-ast::SimpleDataType from_string(const std::string &type) {
+ast::SimpleDataType from_string(std::string_view type) {
     if (type == "void") {
         return ast::SimpleDataType::VOID;
     }
@@ -81,27 +110,3 @@ ast::SimpleDataType from_string(const std::string &type) {
     std::cerr << "Could not convert " << type << " to a simple data type." << std::endl;
     exit(1);
 }
-
-bool ast::isSimpleDataType(const ast::DataType &type) {
-    return type.typeName == "VOID" || type.typeName == "BOOL" || type.typeName == "INT" || type.typeName == "FLOAT" ||
-           type.typeName == "STRING";
-}
-
-ast::SimpleDataType ast::toSimpleDataType(const ast::DataType &type) {
-    if (type.typeName == "VOID") {
-        return ast::SimpleDataType::VOID;
-    }
-    if (type.typeName == "BOOL") {
-        return ast::SimpleDataType::BOOLEAN;
-    }
-    if (type.typeName == "INT") {
-        return ast::SimpleDataType::INTEGER;
-    }
-    if (type.typeName == "FLOAT") {
-        return ast::SimpleDataType::FLOAT;
-    }
-    if (type.typeName == "STRING") {
-        return ast::SimpleDataType::STRING;
-    }
-    return ast::SimpleDataType::VOID;
-}
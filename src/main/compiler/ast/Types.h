@@ -1,26 +1,40 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <utility>
+#include <string_view>
 
 namespace ast {
 enum SimpleDataType { VOID, BOOLEAN, INTEGER, FLOAT, STRING };
 }
 
 std::string to_string(ast::SimpleDataType type);
-ast::SimpleDataType from_string(const std::string &type);
+ast::SimpleDataType from_string(std::string_view type);
 
 namespace ast {
 
+// A handle into the type table. The simple types have the ID of their SimpleDataType, all other types are added to the
+// table the first time they are named. Comparing two data types is an integer compare.
 struct DataType {
-    std::string typeName;
-    explicit DataType() : typeName(to_string(SimpleDataType::VOID)) {}
-    explicit DataType(SimpleDataType simple) : typeName(to_string(simple)) {}
-    explicit DataType(std::string typeName) : typeName(std::move(typeName)) {}
+    uint32_t id;
+    explicit DataType() : id(SimpleDataType::VOID) {}
+    explicit DataType(SimpleDataType simple) : id(simple) {}
+    explicit DataType(std::string_view typeName);
+
+    [[nodiscard]] const std::string &name() const;
+    [[nodiscard]] bool isSimple() const { return id <= SimpleDataType::STRING; }
+    // bool, int and float are passed around by value, all other types by pointer
+    [[nodiscard]] bool isPrimitive() const {
+        return id == SimpleDataType::BOOLEAN || id == SimpleDataType::INTEGER || id == SimpleDataType::FLOAT;
+    }
 };
 
-inline bool operator==(const DataType &lhs, const DataType &rhs) { return lhs.typeName == rhs.typeName; }
-inline bool operator!=(const DataType &lhs, const DataType &rhs) { return lhs.typeName != rhs.typeName; }
+inline bool operator==(const DataType &lhs, const DataType &rhs) { return lhs.id == rhs.id; }
+inline bool operator!=(const DataType &lhs, const DataType &rhs) { return lhs.id != rhs.id; }
+
+// NOTE there is a single table for the whole program, so data types can be created and compared without passing it
+// around. It is safe to use from multiple threads.
+size_t dataTypeCount();
 
 enum class NodeType {
     SEQUENCE,
@@ -63,9 +77,11 @@ enum class UnaryOperationType {
     NEGATE,
 };
 
-bool isSimpleDataType(const ast::DataType &type);
+inline bool isSimpleDataType(const ast::DataType &type) { return type.isSimple(); }
 
-SimpleDataType toSimpleDataType(const ast::DataType &type);
+inline SimpleDataType toSimpleDataType(const ast::DataType &type) {
+    return type.isSimple() ? static_cast<SimpleDataType>(type.id) : SimpleDataType::VOID;
+}
 
 } // namespace ast
 
@@ -77,7 +93,7 @@ std::string to_string(ast::UnaryOperationType operationType);
 namespace std {
 
 template <> struct hash<ast::DataType> {
-    std::size_t operator()(const ast::DataType &k) const { return hash<string>()(k.typeName); }
+    std::size_t operator()(const ast::DataType &k) const { return k.id; }
 };
 
 } // namespace std
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "../AST.h"
+#include "../AstNode.h"
+
+// Base class for all passes over the AST. The derived class passes itself as template parameter, so that every call to
+// one of its visit functions is resolved at compile time and can be inlined.
+//
+// A pass only defines the visit functions for the node types it is interested in, all others visit the children of the
+// node in source order. preVisit is called before a node is visited and can skip it by returning false, postVisit is
+// called after the node and all its children have been visited. Calling stop() ends the whole walk early.
+//
+// NOTE the derived class has to befriend AstVisitor<Derived>, if its visit functions are private
+template <typename Derived> class AstVisitor {
+  public:
+    explicit AstVisitor(const AST *tree = nullptr) : tree(tree) {}
+
+    void visitNode(AstNode *node) {
+        if (stopped || !derived().preVisit(node)) {
+            return;
+        }
+
+        switch (node->type) {
+        case ast::NodeType::SEQUENCE:
+            derived().visitSequenceNode(&node->sequence);
+            break;
+        case ast::NodeType::STATEMENT:
+            derived().visitStatementNode(&node->statement);
+            break;
+        case ast::NodeType::LITERAL:
+            derived().visitLiteralNode(&node->literal);
+            break;
+        case ast::NodeType::UNARY_OPERATION:
+            derived().visitUnaryOperationNode(&node->unary_operation);
+            break;
+        case ast::NodeType::BINARY_OPERATION:
+            derived().visitBinaryOperationNode(&node->binary_operation);
+            break;
+        case ast::NodeType::FUNCTION:
+            derived().visitFunctionNode(&node->function);
+            break;
+        case ast::NodeType::CALL:
+            derived().visitCallNode(&node->call);
+            break;
+        case ast::NodeType::VARIABLE_DEFINITION:
+            derived().visitVariableDefinitionNode(&node->variable_definition);
+            break;
+        case ast::NodeType::VARIABLE:
+            derived().visitVariableNode(&node->variable);
+            break;
+        case ast::NodeType::ASSIGNMENT:
+            derived().visitAssignmentNode(&node->assignment);
+            break;
+        case ast::NodeType::IF_STATEMENT:
+            derived().visitIfStatementNode(&node->if_statement);
+            break;
+        case ast::NodeType::FOR_STATEMENT:
+            derived().visitForStatementNode(&node->for_statement);
+            break;
+        case ast::NodeType::IMPORT:
+            derived().visitImportNode(&node->import);
+            break;
+        case ast::NodeType::TYPE_DECLARATION:
+            derived().visitTypeDeclarationNode(&node->type_declaration);
+            break;
+        case ast::NodeType::TYPE_MEMBER:
+            derived().visitTypeMemberNode(&node->type_member);
+            break;
+        case ast::NodeType::MEMBER_ACCESS:
+            derived().visitMemberAccessNode(&node->member_access);
+            break;
+        case ast::NodeType::ASSERT:
+            derived().visitAssertNode(&node->assert);
+            break;
+        case ast::NodeType::COMMENT:
+            derived().visitCommentNode(&node->comment);
+            break;
+        }
+
+        derived().postVisit(node);
+    }
+
+  protected:
+    const AST *tree;
+
+    bool preVisit(AstNode *node) { return true; }
+    void postVisit(AstNode *node) {}
+
+    void stop() { stopped = true; }
+    [[nodiscard]] bool isStopped() const { return stopped; }
+
+    void visitAssertNode(AssertNode *node) { visitChild(node->condition); }
+    void visitAssignmentNode(AssignmentNode *node) {
+        visitChild(node->left);
+        visitChild(node->right);
+    }
+    void visitBinaryOperationNode(BinaryOperationNode *node) {
+        visitChild(node->left);
+        visitChild(node->right);
+    }
+    void visitCallNode(CallNode *node) { visitChildren(node->arguments); }
+    void visitCommentNode(CommentNode *node) {}
+    void visitForStatementNode(ForStatementNode *node) {
+        visitChild(node->init);
+        visitChild(node->condition);
+        visitChild(node->update);
+        visitChild(node->body);
+    }
+    void visitFunctionNode(FunctionNode *node) {
+        visitChildren(node->arguments);
+        visitChild(node->body);
+    }
+    void visitIfStatementNode(IfStatementNode *node) {
+        visitChild(node->condition);
+        visitChild(node->ifBody);
+        visitChild(node->elseBody);
+    }
+    void visitImportNode(ImportNode *node) {}
+    void visitLiteralNode(LiteralNode *node) {}
+    void visitMemberAccessNode(MemberAccessNode *node) {
+        visitChild(node->left);
+        visitChild(node->right);
+    }
+    void visitSequenceNode(SequenceNode *node) { visitChildren(node->children); }
+    void visitStatementNode(StatementNode *node) { visitChild(node->child); }
+    void visitTypeDeclarationNode(TypeDeclarationNode *node) { visitChildren(node->members); }
+    void visitTypeMemberNode(TypeMemberNode *node) { visitChild(node->variable_definition); }
+    void visitUnaryOperationNode(UnaryOperationNode *node) { visitChild(node->child); }
+    void visitVariableDefinitionNode(VariableDefinitionNode *node) {}
+    void visitVariableNode(VariableNode *node) { visitChild(node->arrayIndex); }
+
+    void visitChild(AstNodeID id) {
+        if (id != NO_NODE) {
+            visitNode(tree->get(id));
+        }
+    }
+    void visitChildren(AstList list) {
+        for (auto *child : tree->nodes(list)) {
+            if (stopped) {
+                return;
+            }
+            visitNode(child);
+        }
+    }
+
+  private:
+    bool stopped = false;
+
+    Derived &derived() { return static_cast<Derived &>(*this); }
+};
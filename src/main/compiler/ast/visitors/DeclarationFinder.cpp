@@ -0,0 +1,63 @@
+#include "DeclarationFinder.h"
+
+void DeclarationFinder::run(AST &tree, ModuleCompileState &state) {
+    this->tree = &tree;
+    this->state = &state;
+    visitNode(tree.root());
+}
+
+bool DeclarationFinder::preVisit(AstNode *node) {
+    // only the top level of the module is searched, the bodies of functions, ifs and loops are skipped
+    switch (node->type) {
+    case ast::NodeType::SEQUENCE:
+    case ast::NodeType::STATEMENT:
+    case ast::NodeType::FUNCTION:
+    case ast::NodeType::IMPORT:
+    case ast::NodeType::TYPE_DECLARATION:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void DeclarationFinder::visitImportNode(ImportNode *node) {
+    auto path = directoryPath / std::filesystem::path(tree->string(node->fileName));
+    state->imports.push_back(path.string());
+}
+
+void DeclarationFinder::visitFunctionNode(FunctionNode *node) {
+    FunctionSignature funcSig = {
+          .name = node->name,
+          .returnType = node->returnType,
+    };
+    for (auto *argument : tree->nodes(node->arguments)) {
+        FunctionArgument funcArg = {
+              .name = argument->variable_definition.name,
+              .type = argument->variable_definition.type,
+        };
+        funcSig.arguments.push_back(funcArg);
+    }
+    state->functions.push_back(funcSig);
+}
+
+void DeclarationFinder::visitTypeDeclarationNode(TypeDeclarationNode *node) {
+    const auto type = ast::DataType(symbolTable.get(node->name));
+    ComplexType complexType = {.type = type};
+    for (auto *member : tree->nodes(node->members)) {
+        const auto &variableDefinition = tree->get(member->type_member.variable_definition)->variable_definition;
+        ComplexTypeMember m = {
+              .name = variableDefinition.name,
+              .type = variableDefinition.type,
+        };
+        complexType.members.push_back(m);
+    }
+    state->complexTypes.push_back(complexType);
+
+    // every type comes with a function that creates a new instance of it
+    FunctionSignature funcSig = {
+          .name = node->name,
+          .returnType = type,
+    };
+    // TODO(henne): add constructor arguments, maybe...
+    state->functions.push_back(funcSig);
+}
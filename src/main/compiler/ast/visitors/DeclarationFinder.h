@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../../../Module.h"
+#include "../../MetaTypes.h"
+#include "../../ModuleCompileState.h"
+#include "../AST.h"
+#include "../AstNode.h"
+#include "AstVisitor.h"
+
+#include <filesystem>
+#include <utility>
+
+// Collects the imports, functions and types that are declared at the top level of a module in a single walk.
+class DeclarationFinder : public AstVisitor<DeclarationFinder> {
+    friend class AstVisitor<DeclarationFinder>;
+
+    std::filesystem::path directoryPath;
+    const SymbolTable &symbolTable;
+    ModuleCompileState *state = nullptr;
+
+  public:
+    DeclarationFinder(std::filesystem::path directoryPath, const SymbolTable &symbolTable)
+        : directoryPath(std::move(directoryPath)), symbolTable(symbolTable) {}
+
+    // adds the declarations to the imports, functions and complexTypes of the state
+    void run(AST &tree, ModuleCompileState &state);
+
+  private:
+    bool preVisit(AstNode *node);
+    void visitFunctionNode(FunctionNode *node);
+    void visitImportNode(ImportNode *node);
+    void visitTypeDeclarationNode(TypeDeclarationNode *node);
+};
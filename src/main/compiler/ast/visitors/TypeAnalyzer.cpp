@@ -2,46 +2,40 @@
 
 #include "util/Utils.h"
 
-void TypeAnalyzer::visitFunctionNode(FunctionNode *node) {
-    for (auto &argument : node->arguments) {
-        visitNode(AST_NODE(argument));
-    }
-    if (!node->is_external()) {
-        visitNode(node->body);
-    }
-}
+void TypeAnalyzer::logError(const std::string &msg) { errors.push_back(msg); }
 
 void TypeAnalyzer::visitCallNode(CallNode *node) {
     auto result = functionResolver.resolveFunction(module, node->name);
     if (!result.functionExists) {
-        std::cerr << "TypeAnalyzer: Undefined function " << node->name << std::endl;
+        logError("TypeAnalyzer: Undefined function " + symbolTable.get(node->name));
         return;
     }
-    for (auto *const arg : node->arguments) {
+    for (auto *const arg : tree->nodes(node->arguments)) {
         visitNode(arg);
     }
-    nodeTypeMap[AST_NODE(node)] = result.signature.returnType;
+    nodeTypeMap[AST_NODE(node)] = result.signature->returnType;
 }
 
 void TypeAnalyzer::visitVariableNode(VariableNode *node) {
     const auto &itr = variableTypeMap.find(node->name);
     if (itr == variableTypeMap.end()) {
-        std::cerr << "TypeAnalyzer: Undefined variable " << node->name << std::endl;
+        logError("TypeAnalyzer: Undefined variable " + symbolTable.get(node->name));
         return;
     }
     nodeTypeMap[AST_NODE(node)] = itr->second;
 }
 
 void TypeAnalyzer::visitVariableDefinitionNode(VariableDefinitionNode *node) {
-    nodeTypeMap[AST_NODE(node)] = node->type;
-    variableTypeMap[node->name] = node->type;
+    const auto type = node->type;
+    nodeTypeMap[AST_NODE(node)] = type;
+    variableTypeMap[node->name] = type;
 }
 
 void TypeAnalyzer::visitBinaryOperationNode(BinaryOperationNode *node) {
-    visitNode(node->left);
-    visitNode(node->right);
-    auto leftType = nodeTypeMap[node->left];
-    auto rightType = nodeTypeMap[node->right];
+    visitNode(tree->get(node->left));
+    visitNode(tree->get(node->right));
+    auto leftType = nodeTypeMap[tree->get(node->left)];
+    auto rightType = nodeTypeMap[tree->get(node->right)];
     if (leftType == rightType) {
         if (node->type == ast::BinaryOperationType::ADDITION || node->type == ast::BinaryOperationType::SUBTRACTION ||
             node->type == ast::BinaryOperationType::MULTIPLICATION ||
@@ -57,38 +51,37 @@ void TypeAnalyzer::visitBinaryOperationNode(BinaryOperationNode *node) {
         }
         return;
     }
-    std::cerr << "TypeAnalyzer: Binary operation type mismatch: " << to_string(leftType) << " " << to_string(node->type)
-              << " " << to_string(rightType) << std::endl;
+    logError("TypeAnalyzer: Binary operation type mismatch: " + to_string(leftType) + " " + to_string(node->type) + " " +
+             to_string(rightType));
 }
 
 void TypeAnalyzer::visitUnaryOperationNode(UnaryOperationNode *node) {
-    visitNode(node->child);
+    visitNode(tree->get(node->child));
     if (node->type == ast::UnaryOperationType::NOT &&
-        nodeTypeMap[node->child] == ast::DataType(ast::SimpleDataType::BOOLEAN)) {
+        nodeTypeMap[tree->get(node->child)] == ast::DataType(ast::SimpleDataType::BOOLEAN)) {
         nodeTypeMap[AST_NODE(node)] = ast::DataType(ast::SimpleDataType::BOOLEAN);
         return;
     }
     if (node->type == ast::UnaryOperationType::NEGATE) {
-        if (nodeTypeMap[node->child] == ast::DataType(ast::SimpleDataType::INTEGER)) {
+        if (nodeTypeMap[tree->get(node->child)] == ast::DataType(ast::SimpleDataType::INTEGER)) {
             nodeTypeMap[AST_NODE(node)] = ast::DataType(ast::SimpleDataType::INTEGER);
             return;
         }
-        if (nodeTypeMap[node->child] == ast::DataType(ast::SimpleDataType::FLOAT)) {
+        if (nodeTypeMap[tree->get(node->child)] == ast::DataType(ast::SimpleDataType::FLOAT)) {
             nodeTypeMap[AST_NODE(node)] = ast::DataType(ast::SimpleDataType::FLOAT);
             return;
         }
     }
-    std::cerr << "TypeAnalyzer: Unary operation type mismatch: " << to_string(node->type) << std::endl;
+    logError("TypeAnalyzer: Unary operation type mismatch: " + to_string(node->type));
 }
 
 void TypeAnalyzer::visitAssignmentNode(AssignmentNode *node) {
-    visitNode(node->right);
-    visitNode(node->left);
-    ast::DataType leftType = nodeTypeMap[node->left];
-    ast::DataType rightType = nodeTypeMap[node->right];
+    visitNode(tree->get(node->right));
+    visitNode(tree->get(node->left));
+    ast::DataType leftType = nodeTypeMap[tree->get(node->left)];
+    ast::DataType rightType = nodeTypeMap[tree->get(node->right)];
     if (leftType != rightType) {
-        std::cerr << "TypeAnalyzer: Assignment type mismatch: " << to_string(leftType) << " = " << to_string(rightType)
-                  << std::endl;
+        logError("TypeAnalyzer: Assignment type mismatch: " + to_string(leftType) + " = " + to_string(rightType));
         return;
     }
 
@@ -96,22 +89,16 @@ void TypeAnalyzer::visitAssignmentNode(AssignmentNode *node) {
 }
 
 void TypeAnalyzer::visitAssertNode(AssertNode *node) {
-    visitNode(node->condition);
-    nodeTypeMap[AST_NODE(node)] = nodeTypeMap[node->condition];
-}
-
-void TypeAnalyzer::visitSequenceNode(SequenceNode *node) {
-    for (auto *child : node->children) {
-        visitNode(child);
-    }
+    visitNode(tree->get(node->condition));
+    nodeTypeMap[AST_NODE(node)] = nodeTypeMap[tree->get(node->condition)];
 }
 
 void TypeAnalyzer::visitStatementNode(StatementNode *node) {
-    if (node->child == nullptr) {
+    if (node->child == NO_NODE) {
         return;
     }
-    visitNode(node->child);
-    nodeTypeMap[AST_NODE(node)] = nodeTypeMap[node->child];
+    visitNode(tree->get(node->child));
+    nodeTypeMap[AST_NODE(node)] = nodeTypeMap[tree->get(node->child)];
 }
 
 void TypeAnalyzer::visitLiteralNode(LiteralNode *node) {
@@ -132,137 +119,78 @@ void TypeAnalyzer::visitLiteralNode(LiteralNode *node) {
 }
 
 void TypeAnalyzer::visitIfStatementNode(IfStatementNode *node) {
-    visitNode(node->condition);
-    if (nodeTypeMap[node->condition] != ast::DataType(ast::SimpleDataType::BOOLEAN)) {
-        std::cerr << "If condition is not of type bool" << std::endl;
+    visitNode(tree->get(node->condition));
+    if (nodeTypeMap[tree->get(node->condition)] != ast::DataType(ast::SimpleDataType::BOOLEAN)) {
+        logError("If condition is not of type bool");
         return;
     }
-    if (node->ifBody != nullptr) {
-        visitNode(node->ifBody);
+    if (node->ifBody != NO_NODE) {
+        visitNode(tree->get(node->ifBody));
     }
-    if (node->elseBody != nullptr) {
-        visitNode(node->elseBody);
+    if (node->elseBody != NO_NODE) {
+        visitNode(tree->get(node->elseBody));
     }
 }
 
 void TypeAnalyzer::visitForStatementNode(ForStatementNode *node) {
-    if (node->init != nullptr) {
-        visitNode(node->init);
+    if (node->init != NO_NODE) {
+        visitNode(tree->get(node->init));
     }
 
-    visitNode(node->condition);
-    if (nodeTypeMap[node->condition] != ast::DataType(ast::SimpleDataType::BOOLEAN)) {
-        std::cerr << "For condition is not of type bool" << std::endl;
+    visitNode(tree->get(node->condition));
+    if (nodeTypeMap[tree->get(node->condition)] != ast::DataType(ast::SimpleDataType::BOOLEAN)) {
+        logError("For condition is not of type bool");
         return;
     }
 
-    if (node->update != nullptr) {
-        visitNode(node->update);
+    if (node->update != NO_NODE) {
+        visitNode(tree->get(node->update));
     }
 
-    if (node->body != nullptr) {
-        visitNode(node->body);
+    if (node->body != NO_NODE) {
+        visitNode(tree->get(node->body));
     }
 }
 
 void TypeAnalyzer::visitTypeDeclarationNode(TypeDeclarationNode *node) {
-    std::vector<ComplexTypeMember> members = {};
-    for (const auto &member : node->members) {
-        ComplexTypeMember m = {
-              member->variable_definition->name,
-              member->variable_definition->type,
-        };
-        members.push_back(m);
-    }
-    complexTypeMap[node->type()] = {node->type(), members};
+    // the members of complex types are looked up through the type resolver, so they must not be added to the variables
 }
 
 void TypeAnalyzer::visitMemberAccessNode(MemberAccessNode *node) {
-    auto variables = node->linearize_access_tree();
+    auto variables = node->linearize_access_tree(*tree);
     if (variables.empty()) {
         log.error("Failed to linearize MemberAccess tree");
         return;
     }
 
-    auto &variableType = variableTypeMap[variables[0]->name];
-    auto currentType = complexTypeMap[variableType];
-    nodeTypeMap[AST_NODE(variables[0])] = currentType.type;
+    auto currentType = variableTypeMap[variables[0]->name];
+    nodeTypeMap[AST_NODE(variables[0])] = currentType;
     for (int i = 1; i < variables.size(); i++) {
         auto *variable = variables[i];
-        for (const auto &member : currentType.members) {
-            if (member.name != variable->name) {
-                continue;
-            }
+        auto resolveResult = typeResolver.resolveType(module, currentType);
+        if (!resolveResult.typeExists) {
+            log.error("Could not resolve type: " + to_string(currentType));
+            return;
+        }
 
-            if (ast::isSimpleDataType(member.type)) {
-                nodeTypeMap[AST_NODE(node)] = member.type;
-                nodeTypeMap[AST_NODE(variable)] = member.type;
-                break;
-            }
+        int memberIndex = resolveResult.layout->memberIndex(variable->name);
+        if (memberIndex == -1) {
+            log.error("Could not find member: " + symbolTable.get(variable->name));
+            return;
+        }
 
-            currentType = complexTypeMap[member.type];
-            nodeTypeMap[AST_NODE(variable)] = currentType.type;
+        currentType = resolveResult.complexType->members[memberIndex].type;
+        nodeTypeMap[AST_NODE(variable)] = currentType;
+        if (ast::isSimpleDataType(currentType)) {
+            nodeTypeMap[AST_NODE(node)] = currentType;
+            break;
         }
     }
 }
 
-std::pair<std::unordered_map<AstNode *, ast::DataType>, std::unordered_map<std::string, ast::DataType>>
-TypeAnalyzer::run(AST &tree) {
+std::pair<NodeMap<ast::DataType>, std::unordered_map<Symbol, ast::DataType>> TypeAnalyzer::run(AST &tree) {
+    this->tree = &tree;
+    nodeTypeMap = NodeMap<ast::DataType>(tree.size());
     visitNode(tree.root());
     return std::make_pair(nodeTypeMap, variableTypeMap);
 }
-
-void TypeAnalyzer::visitNode(AstNode *node) {
-    switch (node->type) {
-    case ast::NodeType::SEQUENCE:
-        visitSequenceNode(&node->sequence);
-        break;
-    case ast::NodeType::STATEMENT:
-        visitStatementNode(&node->statement);
-        break;
-    case ast::NodeType::LITERAL:
-        visitLiteralNode(&node->literal);
-        break;
-    case ast::NodeType::UNARY_OPERATION:
-        visitUnaryOperationNode(&node->unary_operation);
-        break;
-    case ast::NodeType::BINARY_OPERATION:
-        visitBinaryOperationNode(&node->binary_operation);
-        break;
-    case ast::NodeType::FUNCTION:
-        visitFunctionNode(&node->function);
-        break;
-    case ast::NodeType::CALL:
-        visitCallNode(&node->call);
-        break;
-    case ast::NodeType::VARIABLE_DEFINITION:
-        visitVariableDefinitionNode(&node->variable_definition);
-        break;
-    case ast::NodeType::VARIABLE:
-        visitVariableNode(&node->variable);
-        break;
-    case ast::NodeType::ASSIGNMENT:
-        visitAssignmentNode(&node->assignment);
-        break;
-    case ast::NodeType::IF_STATEMENT:
-        visitIfStatementNode(&node->if_statement);
-        break;
-    case ast::NodeType::FOR_STATEMENT:
-        visitForStatementNode(&node->for_statement);
-        break;
-    case ast::NodeType::TYPE_DECLARATION:
-        visitTypeDeclarationNode(&node->type_declaration);
-        break;
-    case ast::NodeType::MEMBER_ACCESS:
-        visitMemberAccessNode(&node->member_access);
-        break;
-    case ast::NodeType::ASSERT:
-        visitAssertNode(&node->assert);
-        break;
-    case ast::NodeType::TYPE_MEMBER:
-    case ast::NodeType::IMPORT:
-    case ast::NodeType::COMMENT:
-        // do nothing
-        break;
-    }
-}
@@ -1,36 +1,47 @@
 #pragma once
 
 #include "../../FunctionResolver.h"
+#include "../../TypeResolver.h"
+#include "../NodeMap.h"
 #include "../Types.h"
+#include "AstVisitor.h"
+#include <string>
 #include <unordered_map>
+#include <vector>
+
+class TypeAnalyzer : public AstVisitor<TypeAnalyzer> {
+    friend class AstVisitor<TypeAnalyzer>;
 
-class TypeAnalyzer {
     const Logger &log;
     Module *module;
+    const SymbolTable &symbolTable;
     const FunctionResolver &functionResolver;
+    const TypeResolver &typeResolver;
 
-    std::unordered_map<AstNode *, ast::DataType> nodeTypeMap = {};
-    std::unordered_map<std::string, ast::DataType> variableTypeMap = {};
-    std::unordered_map<ast::DataType, ComplexType> complexTypeMap = {};
+    NodeMap<ast::DataType> nodeTypeMap = {};
+    std::unordered_map<Symbol, ast::DataType> variableTypeMap = {};
+    std::vector<std::string> errors = {};
 
   public:
-    explicit TypeAnalyzer(const Logger &log, Module *module, const FunctionResolver &functionResolver)
-        : log(log), module(module), functionResolver(functionResolver) {}
+    explicit TypeAnalyzer(const Logger &log, Module *module, const SymbolTable &symbolTable,
+                          const FunctionResolver &functionResolver, const TypeResolver &typeResolver)
+        : log(log), module(module), symbolTable(symbolTable), functionResolver(functionResolver),
+          typeResolver(typeResolver) {}
 
-    std::pair<std::unordered_map<AstNode *, ast::DataType>, std::unordered_map<std::string, ast::DataType>>
-    run(AST &tree);
+    std::pair<NodeMap<ast::DataType>, std::unordered_map<Symbol, ast::DataType>> run(AST &tree);
+    // the errors are printed by the caller, because the modules are analysed in parallel
+    [[nodiscard]] const std::vector<std::string> &getErrors() const { return errors; }
 
   private:
-    void visitNode(AstNode *node);
+    void logError(const std::string &msg);
+
     void visitAssertNode(AssertNode *node);
     void visitAssignmentNode(AssignmentNode *node);
     void visitBinaryOperationNode(BinaryOperationNode *node);
     void visitCallNode(CallNode *node);
     void visitForStatementNode(ForStatementNode *node);
-    void visitFunctionNode(FunctionNode *node);
     void visitIfStatementNode(IfStatementNode *node);
     void visitMemberAccessNode(MemberAccessNode *node);
-    void visitSequenceNode(SequenceNode *node);
     void visitStatementNode(StatementNode *node);
     void visitLiteralNode(LiteralNode *node);
     void visitTypeDeclarationNode(TypeDeclarationNode *node);
@@ -81,35 +81,38 @@ llvm::Value *IrGenerator::createStdLibCall(const std::string &functionName, cons
 }
 
 void IrGenerator::visitFunctionNode(FunctionNode *node) {
-    log.debug("Enter Function");
+    LOG_DEBUG(log, "Enter Function");
 
     llvm::Function *previousFunction = currentFunction;
     bool previousGlobalScopeState = isGlobalScope;
     isGlobalScope = false;
     std::vector<FunctionArgument> arguments = {};
-    for (const auto &arg : node->arguments) {
-        FunctionArgument newArg = {arg->name, arg->type};
+    for (auto *arg : tree->nodes(node->arguments)) {
+        FunctionArgument newArg = {arg->variable_definition.name, arg->variable_definition.type};
         arguments.push_back(newArg);
     }
-    currentFunction = getOrCreateFunctionDefinition(node->name, node->returnType, arguments);
+    const auto &name = symbolTable.get(node->name);
+    const auto returnType = node->returnType;
+    currentFunction = getOrCreateFunctionDefinition(name, returnType, arguments);
 
     if (!node->is_external()) {
-        llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + node->name, currentFunction);
+        llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + name, currentFunction);
         builder.SetInsertPoint(BB);
 
-        withScope([this, &node]() {
+        withScope([this, &node, &returnType]() {
+            unsigned int i = 0;
             for (auto &arg : currentFunction->args()) {
                 auto *value = createEntryBlockAlloca(arg.getType(), arg.getName().str());
 
                 // store initial value
                 builder.CreateStore(&arg, value);
 
-                currentScope().definedVariables[arg.getName().str()] = value;
+                currentScope().definedVariables[tree->nodes(node->arguments)[i++]->variable_definition.name] = value;
             }
 
-            visitNode(node->body);
+            visitNode(tree->get(node->body));
 
-            if (node->returnType != ast::DataType(ast::SimpleDataType::VOID)) {
+            if (returnType != ast::DataType(ast::SimpleDataType::VOID)) {
                 // set insertion point to be before the return statement
                 llvm::BasicBlock &lastBB = currentFunction->getBasicBlockList().back();
                 llvm::BasicBlock::InstListType &instructionList = lastBB.getInstList();
@@ -119,7 +122,7 @@ void IrGenerator::visitFunctionNode(FunctionNode *node) {
         });
     }
 
-    finalizeFunction(currentFunction, node->returnType, node->is_external());
+    finalizeFunction(currentFunction, returnType, node->is_external());
 
     isGlobalScope = previousGlobalScopeState;
     currentFunction = previousFunction;
@@ -127,7 +130,7 @@ void IrGenerator::visitFunctionNode(FunctionNode *node) {
     //      we should save that last insertion point somewhere, instead of guessing it here
     builder.SetInsertPoint(&currentFunction->getBasicBlockList().back());
 
-    log.debug("Exit Function");
+    LOG_DEBUG(log, "Exit Function");
 }
 
 llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const std::string &name, const ast::DataType &returnType,
@@ -156,14 +159,14 @@ llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const std::string &na
 
     unsigned int i = 0;
     for (auto &arg : function->args()) {
-        arg.setName(arguments[i++].name);
+        arg.setName(symbolTable.get(arguments[i++].name));
     }
 
     return function;
 }
 
 llvm::Function *IrGenerator::getOrCreateFunctionDefinition(const FunctionSignature &signature) {
-    return getOrCreateFunctionDefinition(signature.name, signature.returnType, signature.arguments);
+    return getOrCreateFunctionDefinition(symbolTable.get(signature.name), signature.returnType, signature.arguments);
 }
 
 void IrGenerator::finalizeFunction(llvm::Function *function, const ast::DataType &returnType,
@@ -202,18 +205,19 @@ void IrGenerator::finalizeFunction(llvm::Function *function, const ast::DataType
 }
 
 void IrGenerator::visitCallNode(CallNode *node) {
-    log.debug("Enter Function Call");
+    LOG_DEBUG(log, "Enter Function Call");
 
-    llvm::Function *calleeFunc = llvmModule.getFunction(node->name);
+    const auto &name = symbolTable.get(node->name);
+    llvm::Function *calleeFunc = llvmModule.getFunction(name);
     if (calleeFunc == nullptr) {
         const FunctionResolveResult resolveResult = functionResolver.resolveFunction(module, node->name);
         if (!resolveResult.functionExists) {
-            return logError("Undefined function '" + node->name + "'");
+            return logError("Undefined function '" + name + "'");
         }
 
-        calleeFunc = getOrCreateFunctionDefinition(resolveResult.signature);
+        calleeFunc = getOrCreateFunctionDefinition(*resolveResult.signature);
         if (calleeFunc == nullptr) {
-            return logError("Could not generate external definition for function '" + node->name + "'");
+            return logError("Could not generate external definition for function '" + name + "'");
         }
     }
 
@@ -222,16 +226,16 @@ void IrGenerator::visitCallNode(CallNode *node) {
     }
 
     std::vector<llvm::Value *> arguments;
-    for (auto &argument : node->arguments) {
+    for (auto *argument : tree->nodes(node->arguments)) {
         visitNode(argument);
-        auto itr = nodesToValues.find(argument);
-        if (itr == nodesToValues.end()) {
+        auto *value = nodesToValues.get(argument);
+        if (value == nullptr) {
             return logError("Could not generate code for argument.");
         }
         if (typeResolver.getTypeOf(module, argument) == ast::DataType(ast::SimpleDataType::STRING)) {
-            arguments.push_back(builder.CreateLoad(itr->second));
+            arguments.push_back(builder.CreateLoad(value));
         } else {
-            arguments.push_back(itr->second);
+            arguments.push_back(value);
         }
     }
 
@@ -243,10 +247,9 @@ void IrGenerator::visitCallNode(CallNode *node) {
     }
     nodesToValues[AST_NODE(node)] = call;
 
-    log.debug("Exit Function Call");
+    LOG_DEBUG(log, "Exit Function Call");
 }
 
 bool IrGenerator::isPrimitiveType(const ast::DataType &type) {
-    return type == ast::DataType(ast::SimpleDataType::BOOLEAN) || type == ast::DataType(ast::SimpleDataType::INTEGER) ||
-           type == ast::DataType(ast::SimpleDataType::FLOAT);
+    return type.isPrimitive();
 }
@@ -10,13 +10,23 @@
 #include <llvm/Transforms/Utils/Cloning.h>
 
 #include <iostream>
+#include <mutex>
 
 #include "util/Utils.h"
 
-IrGenerator::IrGenerator(const BuildEnv *buildEnv, Module *module, FunctionResolver &functionResolver,
-                         TypeResolver &typeResolver, const Logger &logger)
-    : buildEnv(buildEnv), module(module), functionResolver(functionResolver), typeResolver(typeResolver), log(logger),
-      context(module->llvmModule.getContext()), llvmModule(module->llvmModule), builder(context) {
+namespace {
+
+// the IR of all modules is generated in parallel, but the generators share stdout
+std::mutex outputMutex = {};
+
+} // namespace
+
+IrGenerator::IrGenerator(const BuildEnv *buildEnv, Module *module, const SymbolTable &symbolTable,
+                         const FunctionResolver &functionResolver, const TypeResolver &typeResolver,
+                         const Logger &logger)
+    : AstVisitor(&module->ast), buildEnv(buildEnv), module(module), symbolTable(symbolTable), functionResolver(functionResolver),
+      typeResolver(typeResolver), log(logger), context(module->llvmModule.getContext()),
+      llvmModule(module->llvmModule), builder(context), nodesToValues(module->ast.size()) {
     pushScope();
 }
 
@@ -75,7 +85,7 @@ void IrGenerator::setupGlobalInitialization(llvm::Function *func) {
 }
 
 void IrGenerator::visitSequenceNode(SequenceNode *node) {
-    log.debug("Enter Sequence");
+    LOG_DEBUG(log, "Enter Sequence");
 
     llvm::Function *initFunc = nullptr;
     if (currentFunction == nullptr) {
@@ -91,12 +101,13 @@ void IrGenerator::visitSequenceNode(SequenceNode *node) {
         isGlobalScope = true;
     }
 
-    for (auto *child : node->children) {
+    const auto children = tree->nodes(node->children);
+    for (auto *child : children) {
         visitNode(child);
     }
 
-    if (!node->children.empty()) {
-        nodesToValues[AST_NODE(node)] = nodesToValues[node->children.back()];
+    if (!children.empty()) {
+        nodesToValues[AST_NODE(node)] = nodesToValues[children.back()];
     }
 
     if (initFunc != nullptr) {
@@ -106,41 +117,43 @@ void IrGenerator::visitSequenceNode(SequenceNode *node) {
         isGlobalScope = false;
     }
 
-    log.debug("Exit Sequence");
+    LOG_DEBUG(log, "Exit Sequence");
 }
 
-void IrGenerator::writeToFile() {
+bool IrGenerator::writeToFile() {
     std::string filePath = buildEnv->buildDirectory + module->getFilePath().string() + ".llvm";
     std::error_code EC;
     llvm::raw_fd_ostream dest(filePath, EC, llvm::sys::fs::OF_None);
     if (EC) {
-        llvm::errs() << "Failed to open file (" << filePath << "): " << EC.message() << "\n";
-        exit(1);
+        logError("Failed to open file (" + filePath + "): " + EC.message());
+        return false;
     }
     llvmModule.print(dest, nullptr);
     dest.flush();
     dest.close();
+    return true;
 }
 
-void IrGenerator::run() {
+bool IrGenerator::run() {
     if (!module->ast.is_complete()) {
-        return;
+        return true;
     }
 
     visitNode(module->ast.root());
 
     this->printMetrics();
     if (!errors.empty()) {
-        printErrors();
-        exit(1);
-    } else {
-        if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
-            llvmModule.print(llvm::outs(), nullptr);
-        }
+        return false;
+    }
+
+    if (log.getLogLevel() == Logger::LogLevel::DEBUG_) {
+        std::lock_guard lock(outputMutex);
+        llvmModule.print(llvm::outs(), nullptr);
     }
+    return true;
 }
 
-llvm::Value *IrGenerator::findVariable(const std::string &name) {
+llvm::Value *IrGenerator::findVariable(Symbol name) {
     metrics["variableLookups"]++;
 
     unsigned long currentScope = scopeStack.size() - 1;
@@ -185,11 +198,11 @@ void IrGenerator::printMetrics() {
     }
 
     for (const auto &metric : metrics) {
-        log.debug(metric.first + ": " + std::to_string(metric.second));
+        LOG_DEBUG(log, metric.first + ": " + std::to_string(metric.second));
     }
 }
 
-void IrGenerator::printErrors() {
+void IrGenerator::printErrors(const std::vector<std::string> &errors) {
     std::cerr << std::endl;
     std::cerr << "The following errors occured:" << std::endl;
     for (const auto &msg : errors) {
@@ -5,6 +5,8 @@
 #include "../FunctionResolver.h"
 #include "../TypeResolver.h"
 #include "../ast/AstNode.h"
+#include "../ast/NodeMap.h"
+#include "../ast/visitors/AstVisitor.h"
 #include "Scope.h"
 
 #include <iostream>
@@ -14,10 +16,13 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
-class IrGenerator {
+class IrGenerator : public AstVisitor<IrGenerator> {
+    friend class AstVisitor<IrGenerator>;
+
   public:
-    explicit IrGenerator(const BuildEnv *buildEnv, Module *module, FunctionResolver &functionResolver,
-                         TypeResolver &typeResolver, const Logger &logger);
+    explicit IrGenerator(const BuildEnv *buildEnv, Module *module, const SymbolTable &symbolTable,
+                         const FunctionResolver &functionResolver, const TypeResolver &typeResolver,
+                         const Logger &logger);
 
     void visitAssertNode(AssertNode *node);
     void visitAssignmentNode(AssignmentNode *node);
@@ -35,15 +40,19 @@ class IrGenerator {
     void visitVariableNode(VariableNode *node);
     void visitVariableDefinitionNode(VariableDefinitionNode *node);
 
-    void run();
+    // returns false, if there were errors, they are printed by the caller, because generators run in parallel
+    bool run();
+    [[nodiscard]] const std::vector<std::string> &getErrors() const { return errors; }
+    static void printErrors(const std::vector<std::string> &errors);
 
-    void writeToFile();
+    bool writeToFile();
 
   private:
     const BuildEnv *buildEnv;
     Module *module;
-    FunctionResolver &functionResolver;
-    TypeResolver &typeResolver;
+    const SymbolTable &symbolTable;
+    const FunctionResolver &functionResolver;
+    const TypeResolver &typeResolver;
     const Logger &log;
 
     llvm::LLVMContext &context;
@@ -55,27 +64,37 @@ class IrGenerator {
 
     llvm::Function *currentFunction = nullptr;
     bool isGlobalScope = false;
-    std::unordered_map<AstNode *, llvm::Value *> nodesToValues = {};
+    NodeMap<llvm::Value *> nodesToValues;
     std::vector<Scope> scopeStack = {};
+    // the LLVM types belong to the context of the module, so they are cached here and not in the type table
+    std::vector<llvm::Type *> llvmTypes = {};
+
+    // the LLVM struct of a complex type together with its member types and size, keyed by the id of the data type
+    // NOTE the entries must not move, because creating the members of a type can add the layouts of further types
+    struct LlvmTypeLayout {
+        llvm::StructType *structType = nullptr;
+        std::vector<llvm::Type *> memberTypes = {};
+        uint64_t allocSize = 0;
+    };
+    std::unordered_map<uint32_t, LlvmTypeLayout> llvmTypeLayouts = {};
 
     // This is used to save a pointer to write to (for structs)
     llvm::Value *currentDestination = nullptr;
 
-    llvm::Value *findVariable(const std::string &name);
+    llvm::Value *findVariable(Symbol name);
     Scope &currentScope();
     void pushScope();
     void popScope();
     void withScope(const std::function<void(void)> &func);
 
     void printMetrics();
-    void printErrors();
 
     void logError(const std::string &msg);
     llvm::Type *getType(const ast::DataType &type);
     llvm::Function *getOrCreateFunctionDefinition(const std::string &name, const ast::DataType &returnType,
                                                   const std::vector<FunctionArgument> &arguments);
     llvm::Function *getOrCreateFunctionDefinition(const FunctionSignature &signature);
-    llvm::StructType *getOrCreateComplexType(const ComplexType &type);
+    const LlvmTypeLayout &getOrCreateComplexType(const ComplexType &type);
     llvm::AllocaInst *createEntryBlockAlloca(llvm::Type *type, const std::string &name);
     void finalizeFunction(llvm::Function *function, const ast::DataType &returnType, bool isExternalFunction);
     llvm::Constant *getInitializer(const ast::DataType &dt, bool isArray, unsigned int arraySize);
@@ -93,6 +112,5 @@ class IrGenerator {
     llvm::Value *createStdLibCall(const std::string &functionName, const std::vector<llvm::Value *> &args);
 
     std::string getTypeFormatSpecifier(AstNode *node);
-    void visitNode(AstNode *node);
     void visitLiteralNode(LiteralNode *node);
 };
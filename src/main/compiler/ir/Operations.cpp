@@ -160,19 +160,19 @@ void IrGenerator::emitBooleanOperation(BinaryOperationNode *node, llvm::Value *l
 }
 
 void IrGenerator::visitBinaryOperationNode(BinaryOperationNode *node) {
-    log.debug("Enter BinaryOperation");
+    LOG_DEBUG(log, "Enter BinaryOperation");
 
-    visitNode(node->left);
-    auto *l = nodesToValues[node->left];
-    visitNode(node->right);
-    auto *r = nodesToValues[node->right];
+    visitNode(tree->get(node->left));
+    auto *l = nodesToValues[tree->get(node->left)];
+    visitNode(tree->get(node->right));
+    auto *r = nodesToValues[tree->get(node->right)];
 
     if (l == nullptr || r == nullptr) {
         return logError("Generating left or right side failed.");
     }
 
-    ast::DataType typeOfLeft = typeResolver.getTypeOf(module, node->left);
-    ast::DataType typeOfRight = typeResolver.getTypeOf(module, node->right);
+    ast::DataType typeOfLeft = typeResolver.getTypeOf(module, tree->get(node->left));
+    ast::DataType typeOfRight = typeResolver.getTypeOf(module, tree->get(node->right));
     if (typeOfLeft != typeOfRight) {
         return logError("Types " + to_string(typeOfLeft) + " and " + to_string(typeOfRight) +
                         " are not compatible for binary operation");
@@ -191,14 +191,14 @@ void IrGenerator::visitBinaryOperationNode(BinaryOperationNode *node) {
                         to_string(typeOfRight));
     }
 
-    log.debug("Exit BinaryOperation");
+    LOG_DEBUG(log, "Exit BinaryOperation");
 }
 
 void IrGenerator::visitUnaryOperationNode(UnaryOperationNode *node) {
-    log.debug("Enter UnaryOperation");
+    LOG_DEBUG(log, "Enter UnaryOperation");
 
-    visitNode(node->child);
-    auto *c = nodesToValues[AST_NODE(node->child)];
+    visitNode(tree->get(node->child));
+    auto *c = nodesToValues[tree->get(node->child)];
     if (c == nullptr) {
         return logError("Generating the child failed.");
     }
@@ -222,5 +222,5 @@ void IrGenerator::visitUnaryOperationNode(UnaryOperationNode *node) {
         break;
     }
 
-    log.debug("Exit UnaryOperation");
+    LOG_DEBUG(log, "Exit UnaryOperation");
 }
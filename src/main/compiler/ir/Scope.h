@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../SymbolTable.h"
+
 #include <functional>
 #include <llvm/IR/Value.h>
 #include <unordered_map>
@@ -9,7 +11,7 @@ class Scope {
   public:
     Scope() = default;
 
-    std::unordered_map<std::string, llvm::Value *> definedVariables = {};
+    std::unordered_map<Symbol, llvm::Value *> definedVariables = {};
 
     // TODO find a better name
     std::vector<std::function<void(void)>> cleanUpFunctions = {};
@@ -1,31 +1,31 @@
 #include "IrGenerator.h"
 
 void IrGenerator::visitStatementNode(StatementNode *node) {
-    log.debug("Enter Statement");
+    LOG_DEBUG(log, "Enter Statement");
 
-    if (node->child == nullptr) {
+    if (node->child == NO_NODE) {
         return;
     }
 
-    visitNode(node->child);
-    auto *value = nodesToValues[node->child];
+    visitNode(tree->get(node->child));
+    auto *value = nodesToValues[tree->get(node->child)];
     if (node->returnStatement) {
         builder.CreateRet(value);
     }
     nodesToValues[AST_NODE(node)] = value;
 
-    log.debug("Exit Statement");
+    LOG_DEBUG(log, "Exit Statement");
 }
 
-bool hasReturnStatement(AstNode *node) {
+bool hasReturnStatement(const AST &tree, AstNode *node) {
     if (node == nullptr) {
         return false;
     }
     switch (node->type) {
     case ast::NodeType::SEQUENCE: {
-        auto children = node->sequence.children;
+        auto children = tree.nodes(node->sequence.children);
         if (!children.empty()) {
-            return hasReturnStatement(children[children.size() - 1]);
+            return hasReturnStatement(tree, children[children.size() - 1]);
         }
         return false;
     }
@@ -47,10 +47,10 @@ bool hasReturnStatement(AstNode *node) {
 }
 
 void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
-    log.debug("Enter IfStatement");
+    LOG_DEBUG(log, "Enter IfStatement");
 
-    visitNode(node->condition);
-    auto *condition = nodesToValues[node->condition];
+    visitNode(tree->get(node->condition));
+    auto *condition = nodesToValues[tree->get(node->condition)];
 
     llvm::Function *function = builder.GetInsertBlock()->getParent();
     llvm::BasicBlock *thenBB = llvm::BasicBlock::Create(context, "then", function);
@@ -60,10 +60,10 @@ void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
     builder.CreateCondBr(condition, thenBB, elseBB);
 
     builder.SetInsertPoint(thenBB);
-    if (node->ifBody != nullptr) {
-        withScope([this, &node]() { visitNode(node->ifBody); });
+    if (node->ifBody != NO_NODE) {
+        withScope([this, &node]() { visitNode(tree->get(node->ifBody)); });
     }
-    if (!hasReturnStatement(node->ifBody)) {
+    if (!hasReturnStatement(*tree, tree->get(node->ifBody))) {
         // create branch instruction to jump to the merge block
         builder.CreateBr(mergeBB);
     }
@@ -71,10 +71,10 @@ void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
     function->getBasicBlockList().push_back(elseBB);
     builder.SetInsertPoint(elseBB);
 
-    if (node->elseBody != nullptr) {
-        withScope([this, &node]() { visitNode(node->elseBody); });
+    if (node->elseBody != NO_NODE) {
+        withScope([this, &node]() { visitNode(tree->get(node->elseBody)); });
     }
-    if (!hasReturnStatement(node->elseBody)) {
+    if (!hasReturnStatement(*tree, tree->get(node->elseBody))) {
         // create branch instruction to jump to the merge block
         builder.CreateBr(mergeBB);
     }
@@ -82,14 +82,14 @@ void IrGenerator::visitIfStatementNode(IfStatementNode *node) {
     function->getBasicBlockList().push_back(mergeBB);
     builder.SetInsertPoint(mergeBB);
 
-    log.debug("Exit IfStatement");
+    LOG_DEBUG(log, "Exit IfStatement");
 }
 
 void IrGenerator::visitForStatementNode(ForStatementNode *node) {
-    log.debug("Enter ForStatement");
+    LOG_DEBUG(log, "Enter ForStatement");
     pushScope();
 
-    visitNode(node->init);
+    visitNode(tree->get(node->init));
 
     llvm::Function *function = builder.GetInsertBlock()->getParent();
     llvm::BasicBlock *loopHeaderBB = llvm::BasicBlock::Create(context, "loop-header", function);
@@ -98,18 +98,18 @@ void IrGenerator::visitForStatementNode(ForStatementNode *node) {
     builder.CreateBr(loopHeaderBB);
     builder.SetInsertPoint(loopHeaderBB);
 
-    visitNode(node->condition);
-    auto *condition = nodesToValues[node->condition];
+    visitNode(tree->get(node->condition));
+    auto *condition = nodesToValues[tree->get(node->condition)];
 
     builder.CreateCondBr(condition, loopBodyBB, loopExitBB);
 
     builder.SetInsertPoint(loopBodyBB);
 
-    if (node->body != nullptr) {
-        visitNode(node->body);
+    if (node->body != NO_NODE) {
+        visitNode(tree->get(node->body));
     }
 
-    visitNode(node->update);
+    visitNode(tree->get(node->update));
 
     popScope();
 
@@ -117,7 +117,7 @@ void IrGenerator::visitForStatementNode(ForStatementNode *node) {
 
     builder.SetInsertPoint(loopExitBB);
 
-    log.debug("Exit ForStatement");
+    LOG_DEBUG(log, "Exit ForStatement");
 }
 
 std::string IrGenerator::getTypeFormatSpecifier(AstNode* node) {
@@ -132,10 +132,10 @@ std::string IrGenerator::getTypeFormatSpecifier(AstNode* node) {
 }
 
 void IrGenerator::visitAssertNode(AssertNode *node) {
-    log.debug("Enter Assert");
+    LOG_DEBUG(log, "Enter Assert");
 
-    visitNode(node->condition);
-    auto *condition = nodesToValues[node->condition];
+    visitNode(tree->get(node->condition));
+    auto *condition = nodesToValues[tree->get(node->condition)];
 
     llvm::Function *function = builder.GetInsertBlock()->getParent();
     llvm::BasicBlock *thenBB = llvm::BasicBlock::Create(context, "then", function);
@@ -151,16 +151,16 @@ void IrGenerator::visitAssertNode(AssertNode *node) {
     function->getBasicBlockList().push_back(elseBB);
     builder.SetInsertPoint(elseBB);
 
-    if (node->condition->type == ast::NodeType::BINARY_OPERATION) {
-        auto binaryOperation = &node->condition->binary_operation;
-        const std::string leftTypeSpecifier = getTypeFormatSpecifier(binaryOperation->left);
-        const std::string rightTypeSpecifier = getTypeFormatSpecifier(binaryOperation->right);
+    if (tree->get(node->condition)->type == ast::NodeType::BINARY_OPERATION) {
+        auto binaryOperation = &tree->get(node->condition)->binary_operation;
+        const std::string leftTypeSpecifier = getTypeFormatSpecifier(tree->get(binaryOperation->left));
+        const std::string rightTypeSpecifier = getTypeFormatSpecifier(tree->get(binaryOperation->right));
         const std::string format = "> assert %s\nE assert %" + leftTypeSpecifier +
                                    binaryOperation->operation_string() + "%" + rightTypeSpecifier + "\n";
         auto *const formatStr = builder.CreateGlobalStringPtr(format);
         auto *const conditionStr = builder.CreateGlobalStringPtr(to_string(AST_NODE(binaryOperation)));
-        auto *const left = nodesToValues[binaryOperation->left];
-        auto *const right = nodesToValues[binaryOperation->right];
+        auto *const left = nodesToValues[tree->get(binaryOperation->left)];
+        auto *const right = nodesToValues[tree->get(binaryOperation->right)];
         std::vector<llvm::Value *> args = {
               formatStr,
               conditionStr,
@@ -171,7 +171,7 @@ void IrGenerator::visitAssertNode(AssertNode *node) {
     } else {
         const std::string format = "E assert %s\n";
         auto *const formatStr = builder.CreateGlobalStringPtr(format);
-        auto *const conditionStr = builder.CreateGlobalStringPtr(to_string(node->condition));
+        auto *const conditionStr = builder.CreateGlobalStringPtr(to_string(tree->get(node->condition)));
         std::vector<llvm::Value *> args = {
               formatStr,
               conditionStr,
@@ -189,5 +189,5 @@ void IrGenerator::visitAssertNode(AssertNode *node) {
     function->getBasicBlockList().push_back(mergeBB);
     builder.SetInsertPoint(mergeBB);
 
-    log.debug("Exit Assert");
+    LOG_DEBUG(log, "Exit Assert");
 }
@@ -3,20 +3,30 @@
 const int NUM_BITS_OF_INT = 64;
 
 llvm::Type *IrGenerator::getType(const ast::DataType &type) {
+    if (type.id < llvmTypes.size() && llvmTypes[type.id] != nullptr) {
+        return llvmTypes[type.id];
+    }
+
+    llvm::Type *result = nullptr;
     bool isSimpleType = ast::isSimpleDataType(type);
     if (isSimpleType) {
         ast::SimpleDataType simpleDataType = toSimpleDataType(type);
         switch (simpleDataType) {
         case ast::SimpleDataType::VOID:
-            return llvm::Type::getVoidTy(context);
+            result = llvm::Type::getVoidTy(context);
+            break;
         case ast::SimpleDataType::INTEGER:
-            return llvm::Type::getInt64Ty(context);
+            result = llvm::Type::getInt64Ty(context);
+            break;
         case ast::SimpleDataType::FLOAT:
-            return llvm::Type::getDoubleTy(context);
+            result = llvm::Type::getDoubleTy(context);
+            break;
         case ast::SimpleDataType::BOOLEAN:
-            return llvm::Type::getInt1Ty(context);
+            result = llvm::Type::getInt1Ty(context);
+            break;
         case ast::SimpleDataType::STRING:
-            return getStringType()->getPointerTo();
+            result = getStringType()->getPointerTo();
+            break;
         default:
             return nullptr;
         }
@@ -27,25 +37,44 @@ llvm::Type *IrGenerator::getType(const ast::DataType &type) {
             return llvm::Type::getVoidTy(context);
         }
 
-        auto *result = getOrCreateComplexType(resolveResult.complexType);
-        if (result == nullptr) {
+        auto *complexType = getOrCreateComplexType(*resolveResult.complexType).structType;
+        if (complexType == nullptr) {
             logError("Could not generate type declaration for type '" + to_string(type) + "'");
             return llvm::Type::getVoidTy(context);
         }
-        return result->getPointerTo();
+        result = complexType->getPointerTo();
     }
+
+    if (type.id >= llvmTypes.size()) {
+        llvmTypes.resize(type.id + 1, nullptr);
+    }
+    llvmTypes[type.id] = result;
+    return result;
 }
 
-llvm::StructType *IrGenerator::getOrCreateComplexType(const ComplexType &type) {
-    auto *result = llvm::StructType::getTypeByName(context, type.type.typeName);
-    if (result != nullptr) {
-        return result;
+const IrGenerator::LlvmTypeLayout &IrGenerator::getOrCreateComplexType(const ComplexType &type) {
+    auto itr = llvmTypeLayouts.find(type.type.id);
+    if (itr != llvmTypeLayouts.end()) {
+        return itr->second;
+    }
+
+    // the struct is registered before its members are created, so that members can refer back to it
+    auto &layout = llvmTypeLayouts[type.type.id];
+    layout.structType = llvm::StructType::getTypeByName(context, type.type.name());
+    const bool isNewType = layout.structType == nullptr;
+    if (isNewType) {
+        layout.structType = llvm::StructType::create(context, type.type.name());
     }
-    std::vector<llvm::Type *> elements = {};
+
     for (const auto &member : type.members) {
-        elements.push_back(getType(member.type));
+        layout.memberTypes.push_back(getType(member.type));
+    }
+    if (isNewType) {
+        layout.structType->setBody(layout.memberTypes);
     }
-    return llvm::StructType::create(context, elements, type.type.typeName);
+
+    layout.allocSize = llvmModule.getDataLayout().getTypeAllocSize(layout.structType).getFixedSize();
+    return layout;
 }
 
 llvm::StructType *IrGenerator::getStringType() {
@@ -66,15 +95,15 @@ void IrGenerator::visitLiteralNode(LiteralNode *node) {
     switch (node->type) {
     case LiteralType::BOOL:
         nodesToValues[AST_NODE(node)] = llvm::ConstantInt::get(context, llvm::APInt(1, static_cast<uint64_t>(node->b)));
-        log.debug("Created Bool");
+        LOG_DEBUG(log, "Created Bool");
         break;
     case LiteralType::INTEGER:
         nodesToValues[AST_NODE(node)] = llvm::ConstantInt::get(context, llvm::APInt(NUM_BITS_OF_INT, node->i));
-        log.debug("Created Integer");
+        LOG_DEBUG(log, "Created Integer");
         break;
     case LiteralType::FLOAT:
         nodesToValues[AST_NODE(node)] = llvm::ConstantFP::get(context, llvm::APFloat(node->d));
-        log.debug("Created Float");
+        LOG_DEBUG(log, "Created Float");
         break;
     case LiteralType::STRING:
         visitStringNode(node);
@@ -88,7 +117,7 @@ void IrGenerator::visitStringNode(LiteralNode *node) {
     //      call function that inits string
     // going with second option for now
 
-    const std::string stringValue = node->s;
+    const std::string stringValue = std::string(tree->string(node->s));
     unsigned int numCharacters = stringValue.size();
     auto *data = builder.CreateGlobalStringPtr(stringValue, "str");
     auto *size = llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), numCharacters);
@@ -112,41 +141,44 @@ void IrGenerator::visitStringNode(LiteralNode *node) {
         createStdLibCall("deleteString", args);
     });
 
-    log.debug("Created String");
+    LOG_DEBUG(log, "Created String");
 }
 
 void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
-    auto *functionDef = getOrCreateFunctionDefinition(node->name, node->type(), {});
-    llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + node->name, functionDef);
+    const auto &name = symbolTable.get(node->name);
+    const auto type = ast::DataType(name);
+    auto *functionDef = getOrCreateFunctionDefinition(name, type, {});
+    llvm::BasicBlock *BB = llvm::BasicBlock::Create(context, "entry-" + name, functionDef);
     builder.SetInsertPoint(BB);
 
-    auto *complexType = getType(node->type());
-    auto dataLayout = llvmModule.getDataLayout();
-    auto typeSize = dataLayout.getTypeAllocSize(complexType);
-    auto fixedTypeSize = typeSize.getFixedSize();
-    std::vector<llvm::Value *> args = {llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), fixedTypeSize)};
-    auto *result = createStdLibCall("malloc", args);
-    auto *castedResult = builder.CreateBitOrPointerCast(result, complexType);
+    TypeResolveResult resolveResult = typeResolver.resolveType(module, type);
+    if (!resolveResult.typeExists) {
+        return logError("Undefined type '" + to_string(type) + "'");
+    }
+    const auto &layout = getOrCreateComplexType(*resolveResult.complexType);
 
-    for (int i = 0; i < node->members.size(); i++) {
-        auto member = node->members[i];
+    std::vector<llvm::Value *> args = {llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), layout.allocSize)};
+    auto *result = createStdLibCall("malloc", args);
+    auto *castedResult = builder.CreateBitOrPointerCast(result, getType(type));
 
-        auto *memberType = getType(member->variable_definition->type);
+    const auto members = tree->nodes(node->members);
+    for (int i = 0; i < members.size(); i++) {
+        auto member = members[i];
 
-        auto llvmT = getType(node->type());
-        auto elementType = llvmT->getPointerElementType();
+        const auto &variableDefinition = tree->get(member->type_member.variable_definition)->variable_definition;
+        const auto memberDataType = variableDefinition.type;
+        auto *elementType = layout.structType;
 
         llvm::Value *indexOfBaseVariable = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
         llvm::Value *indexOfMember = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), i);
         std::vector<llvm::Value *> indices = {indexOfBaseVariable, indexOfMember};
 
         auto address = builder.CreateInBoundsGEP(elementType, castedResult, indices, "memberAccess");
-        if (!ast::isSimpleDataType(member->variable_definition->type)) {
-            auto subTypeFuncDef = getOrCreateFunctionDefinition(member->variable_definition->type.typeName,
-                                                                member->variable_definition->type, {});
+        if (!ast::isSimpleDataType(memberDataType)) {
+            auto subTypeFuncDef = getOrCreateFunctionDefinition(memberDataType.name(), memberDataType, {});
             auto funcResult = builder.CreateCall(subTypeFuncDef, {});
             builder.CreateStore(funcResult, address);
-        } else if (member->variable_definition->type == ast::DataType(ast::SimpleDataType::STRING)) {
+        } else if (memberDataType == ast::DataType(ast::SimpleDataType::STRING)) {
             int defaultSize = 32;
             auto data = llvm::ConstantPointerNull::get(llvm::Type::getInt8PtrTy(context));
             auto size = llvm::ConstantInt::get(llvm::IntegerType::getInt64Ty(context), 0);
@@ -157,7 +189,7 @@ void IrGenerator::visitTypeDeclarationNode(TypeDeclarationNode *node) {
             builder.CreateStore(funcResult, address);
         } else {
             llvm::Value *value = nullptr;
-            switch (ast::toSimpleDataType(member->variable_definition->type)) {
+            switch (ast::toSimpleDataType(memberDataType)) {
             case ast::SimpleDataType::INTEGER:
                 value = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 0);
                 break;
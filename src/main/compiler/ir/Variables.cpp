@@ -3,23 +3,23 @@
 #include "util/Utils.h"
 
 void IrGenerator::visitVariableNode(VariableNode *node) {
-    log.debug("Enter Variable");
+    LOG_DEBUG(log, "Enter Variable");
 
     auto *value = findVariable(node->name);
     if (value == nullptr) {
-        return logError("Undefined variable '" + node->name + "'");
+        return logError("Undefined variable '" + symbolTable.get(node->name) + "'");
     }
 
     if (node->is_array_access()) {
-        visitNode(node->arrayIndex);
+        visitNode(tree->get(node->arrayIndex));
         llvm::Value *indexOfArray = llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), 0);
-        auto *arrayIndex = nodesToValues[node->arrayIndex];
+        auto *arrayIndex = nodesToValues[tree->get(node->arrayIndex)];
         std::vector<llvm::Value *> indices = {indexOfArray, arrayIndex};
         auto *elementPtr = builder.CreateInBoundsGEP(value, indices);
         nodesToValues[AST_NODE(node)] = builder.CreateLoad(elementPtr);
     } else {
         if (isPrimitiveType(typeResolver.getTypeOf(module, AST_NODE(node)))) {
-            llvm::Value *loadedValue = builder.CreateLoad(value, node->name);
+            llvm::Value *loadedValue = builder.CreateLoad(value, symbolTable.get(node->name));
             nodesToValues[AST_NODE(node)] = loadedValue;
         } else {
             // this directly passes the pointer, instead of loading the value first
@@ -27,14 +27,15 @@ void IrGenerator::visitVariableNode(VariableNode *node) {
         }
     }
 
-    log.debug("Exit Variable");
+    LOG_DEBUG(log, "Exit Variable");
 }
 
 void IrGenerator::visitVariableDefinitionNode(VariableDefinitionNode *node) {
-    log.debug("Enter VariableDefinition");
+    LOG_DEBUG(log, "Enter VariableDefinition");
 
-    llvm::Type *type = getType(node->type);
-    std::string &name = node->name;
+    const auto dataType = node->type;
+    llvm::Type *type = getType(dataType);
+    const std::string &name = symbolTable.get(node->name);
 
     if (node->is_array()) {
         type = llvm::ArrayType::get(type, node->arraySize);
@@ -44,7 +45,7 @@ void IrGenerator::visitVariableDefinitionNode(VariableDefinitionNode *node) {
     if (isGlobalScope) {
         value = llvmModule.getOrInsertGlobal(name, type);
         llvmModule.getNamedGlobal(name)->setDSOLocal(true);
-        llvmModule.getNamedGlobal(name)->setInitializer(getInitializer(node->type, node->is_array(), node->arraySize));
+        llvmModule.getNamedGlobal(name)->setInitializer(getInitializer(dataType, node->is_array(), node->arraySize));
     } else {
         value = createEntryBlockAlloca(type, name);
         if (node->is_array()) {
@@ -64,56 +65,58 @@ void IrGenerator::visitVariableDefinitionNode(VariableDefinitionNode *node) {
         }
     }
 
-    currentScope().definedVariables[name] = value;
+    currentScope().definedVariables[node->name] = value;
     nodesToValues[AST_NODE(node)] = value;
 
-    log.debug("Exit VariableDefinition");
+    LOG_DEBUG(log, "Exit VariableDefinition");
 }
 
 void IrGenerator::visitAssignmentNode(AssignmentNode *node) {
-    log.debug("Enter Assignment");
+    LOG_DEBUG(log, "Enter Assignment");
 
+    auto *left = tree->get(node->left);
+    auto *right = tree->get(node->right);
     llvm::Value *dest = nullptr;
-    if (node->left->type == ast::NodeType::VARIABLE_DEFINITION) {
+    if (left->type == ast::NodeType::VARIABLE_DEFINITION) {
         // generate variable definition
-        visitNode(node->left);
-        dest = nodesToValues[node->left];
-    } else if (node->left->type == ast::NodeType::VARIABLE) {
+        visitNode(left);
+        dest = nodesToValues[left];
+    } else if (left->type == ast::NodeType::VARIABLE) {
         // lookup the variable to save into
-        auto *variable = reinterpret_cast<VariableNode *>(node->left);
+        auto *variable = &left->variable;
         dest = findVariable(variable->name);
         if (variable->is_array_access()) {
-            visitNode(variable->arrayIndex);
+            visitNode(tree->get(variable->arrayIndex));
 
             // This first accesses the array
             llvm::Value *indexOfArray = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
             // and then indexes into the array, for multi dimensional array access
-            llvm::Value *indexInsideArray = nodesToValues[variable->arrayIndex];
+            llvm::Value *indexInsideArray = nodesToValues[tree->get(variable->arrayIndex)];
             std::vector<llvm::Value *> indices = {indexOfArray, indexInsideArray};
             dest = builder.CreateInBoundsGEP(dest, indices);
         }
-    } else if (node->left->type == ast::NodeType::MEMBER_ACCESS) {
+    } else if (left->type == ast::NodeType::MEMBER_ACCESS) {
         // TODO(henne): this is a hack!
         //  setting currentDestination to 1 is used as a flag to signal to visitMemberAccessNode that we are going to
         //  write to its result
         currentDestination = reinterpret_cast<llvm::Value *>(1);
-        visitNode(node->left);
-        dest = nodesToValues[node->left];
+        visitNode(left);
+        dest = nodesToValues[left];
     } else {
-        return logError("Could not handle assignment to " + to_string(node->left->type));
+        return logError("Could not handle assignment to " + to_string(left->type));
     }
 
     currentDestination = dest;
-    visitNode(node->right);
+    visitNode(right);
     currentDestination = nullptr;
 
-    llvm::Value *src = nodesToValues[node->right];
+    llvm::Value *src = nodesToValues[right];
     if (src == nullptr || dest == nullptr) {
         return logError("Could not create assignment.");
     }
 
-    if (typeResolver.getTypeOf(module, node->right) == ast::DataType(ast::SimpleDataType::STRING)) {
-        if (node->left->type != ast::NodeType::VARIABLE_DEFINITION) {
+    if (typeResolver.getTypeOf(module, right) == ast::DataType(ast::SimpleDataType::STRING)) {
+        if (left->type != ast::NodeType::VARIABLE_DEFINITION) {
             llvm::Value *loadedDest = builder.CreateLoad(dest);
             llvm::Value *loadedSrc = builder.CreateLoad(src);
             std::vector<llvm::Value *> args = {loadedDest, loadedSrc};
@@ -124,13 +127,13 @@ void IrGenerator::visitAssignmentNode(AssignmentNode *node) {
         nodesToValues[AST_NODE(node)] = builder.CreateStore(src, dest);
     }
 
-    log.debug("Exit Assignment");
+    LOG_DEBUG(log, "Exit Assignment");
 }
 
 void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
-    log.debug("Enter MemberAccess");
+    LOG_DEBUG(log, "Enter MemberAccess");
 
-    auto variables = node->linearize_access_tree();
+    auto variables = node->linearize_access_tree(*tree);
     if (variables.empty()) {
         return logError("Failed to linearize MemberAccess tree");
     }
@@ -140,36 +143,27 @@ void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
     llvm::Value *indexOfBaseVariable = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
     std::vector<llvm::Value *> indices = {indexOfBaseVariable};
 
-    ast::DataType previousType = ast::DataType();
+    // the types along the access path follow from the member types, only the base variable has to be looked up
+    auto currentType = typeResolver.getTypeOf(module, AST_NODE(variables[0]));
+    llvm::StructType *elementType = nullptr;
     for (int i = 1; i < variables.size(); i++) {
-        previousType = typeResolver.getTypeOf(module, AST_NODE(variables[i - 1]));
-
-        auto resolveResult = typeResolver.resolveType(module, previousType);
+        auto resolveResult = typeResolver.resolveType(module, currentType);
         if (!resolveResult.typeExists) {
-            return logError("Could not resolve type: " + to_string(previousType));
+            return logError("Could not resolve type: " + to_string(currentType));
         }
 
-        int memberIndex = -1;
-        bool isComplexType = false;
-        for (int j = 0; j < resolveResult.complexType.members.size(); j++) {
-            if (resolveResult.complexType.members[j].name == variables[i]->name) {
-                memberIndex = j;
-                isComplexType = !ast::isSimpleDataType(resolveResult.complexType.members[j].type);
-                break;
-            }
-        }
+        const int memberIndex = resolveResult.layout->memberIndex(variables[i]->name);
         if (memberIndex == -1) {
-            return logError("Could not find member: " + variables[i]->name);
+            return logError("Could not find member: " + symbolTable.get(variables[i]->name));
         }
 
         llvm::Value *indexOfMember = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), memberIndex);
         indices.push_back(indexOfMember);
 
-        if (isComplexType) {
+        elementType = getOrCreateComplexType(*resolveResult.complexType).structType;
+        currentType = resolveResult.complexType->members[memberIndex].type;
+        if (!ast::isSimpleDataType(currentType)) {
             // dereference the pointer to the complex type
-            auto llvmT = getType(previousType);
-            auto elementType = llvmT->getPointerElementType();
-
             result = builder.CreateLoad(result);
             result = builder.CreateInBoundsGEP(elementType, result, indices, "memberAccess");
 
@@ -178,9 +172,6 @@ void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
         }
     }
 
-    auto llvmT = getType(previousType);
-    auto elementType = llvmT->getPointerElementType();
-
     result = builder.CreateLoad(result);
     result = builder.CreateInBoundsGEP(elementType, result, indices, "memberAccess");
 
@@ -192,59 +183,5 @@ void IrGenerator::visitMemberAccessNode(MemberAccessNode *node) {
 
     nodesToValues[AST_NODE(node)] = result;
 
-    log.debug("Exit MemberAccess");
-}
-
-void IrGenerator::visitNode(AstNode *node) {
-    switch (node->type) {
-    case ast::NodeType::SEQUENCE:
-        visitSequenceNode(&node->sequence);
-        break;
-    case ast::NodeType::STATEMENT:
-        visitStatementNode(&node->statement);
-        break;
-    case ast::NodeType::LITERAL:
-        visitLiteralNode(&node->literal);
-        break;
-    case ast::NodeType::UNARY_OPERATION:
-        visitUnaryOperationNode(&node->unary_operation);
-        break;
-    case ast::NodeType::BINARY_OPERATION:
-        visitBinaryOperationNode(&node->binary_operation);
-        break;
-    case ast::NodeType::FUNCTION:
-        visitFunctionNode(&node->function);
-        break;
-    case ast::NodeType::CALL:
-        visitCallNode(&node->call);
-        break;
-    case ast::NodeType::VARIABLE_DEFINITION:
-        visitVariableDefinitionNode(&node->variable_definition);
-        break;
-    case ast::NodeType::VARIABLE:
-        visitVariableNode(&node->variable);
-        break;
-    case ast::NodeType::ASSIGNMENT:
-        visitAssignmentNode(&node->assignment);
-        break;
-    case ast::NodeType::IF_STATEMENT:
-        visitIfStatementNode(&node->if_statement);
-        break;
-    case ast::NodeType::FOR_STATEMENT:
-        visitForStatementNode(&node->for_statement);
-        break;
-    case ast::NodeType::TYPE_DECLARATION:
-        visitTypeDeclarationNode(&node->type_declaration);
-        break;
-    case ast::NodeType::MEMBER_ACCESS:
-        visitMemberAccessNode(&node->member_access);
-        break;
-    case ast::NodeType::ASSERT:
-        visitAssertNode(&node->assert);
-        break;
-    case ast::NodeType::COMMENT:
-    case ast::NodeType::TYPE_MEMBER:
-    case ast::NodeType::IMPORT:
-        break;
-    }
+    LOG_DEBUG(log, "Exit MemberAccess");
 }
@@ -3,72 +3,132 @@
 #include <fstream>
 #include <iostream>
 #include <optional>
-#include <regex>
 
+#include "Scanner.h"
 #include "util/Utils.h"
 
-std::optional<std::string> ByteCodeProvider::getMoreCode() {
+#if !WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::optional<std::string_view> ByteCodeProvider::getMoreCode() {
     if (size == 0) {
         return {};
     }
 
-    std::string s;
-    while (*data != '\n' && size > 0) {
-        s += *data;
-        data++;
-        size--;
+    long length = 0;
+    while (length < size && data[length] != '\n') {
+        length++;
     }
-    if (*data == '\n' && size > 0) {
-        data++;
-        size--;
+    std::string_view result(data, length);
+    if (length < size) {
+        // skip the line break
+        length++;
     }
-    return std::optional<std::string>(s);
+    data += length;
+    size -= length;
+    return std::optional(result);
 }
 
-std::optional<std::string> FileCodeProvider::getMoreCode() {
-    if (!fileHasBeenRead) {
-        fileHasBeenRead = true;
-        std::ifstream infile(fileName);
-        if (!infile.good()) {
-            std::cerr << "Could not read file '" << fileName << "'." << std::endl;
-        }
-        std::string line;
-        while (std::getline(infile, line)) {
-            lines.push_back(line + "\n");
-        }
+FileCodeProvider::~FileCodeProvider() {
+#if !WIN32
+    if (mappedData != nullptr) {
+        munmap(mappedData, mappedSize);
     }
+#endif
+}
 
-    if (lines.empty()) {
-        return {};
+bool FileCodeProvider::mapFile() {
+#if WIN32
+    return false;
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
     }
 
-    std::string result = lines.front();
-    lines.erase(lines.begin());
-    return std::optional(result);
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    const auto fileSize = static_cast<size_t>(fileStat.st_size);
+    void *data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    // NOTE the last line has to end with a line break, which we can't append to a read-only mapping
+    const auto *chars = static_cast<const char *>(data);
+    if (chars[fileSize - 1] != '\n') {
+        munmap(data, fileSize);
+        return false;
+    }
+
+    mappedData = data;
+    mappedSize = fileSize;
+    source = std::string_view(chars, fileSize);
+    return true;
+#endif
 }
 
-std::optional<std::string> StringCodeProvider::getMoreCode() {
-    if (lines.empty()) {
+void FileCodeProvider::readFile() {
+    std::ifstream infile(fileName);
+    if (!infile.good()) {
+        std::cerr << "Could not read file '" << fileName << "'." << std::endl;
+        return;
+    }
+
+    infile.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::streamsize>(infile.tellg());
+    infile.seekg(0, std::ios::beg);
+    readBuffer.resize(fileSize);
+    infile.read(readBuffer.data(), fileSize);
+    readBuffer.resize(infile.gcount());
+
+    if (!readBuffer.empty() && readBuffer.back() != '\n') {
+        readBuffer += '\n';
+    }
+    source = readBuffer;
+}
+
+std::optional<std::string_view> FileCodeProvider::getMoreCode() {
+    if (fileHasBeenRead) {
+        return {};
+    }
+
+    fileHasBeenRead = true;
+    if (!mapFile()) {
+        readFile();
+    }
+    if (source.empty()) {
         return {};
     }
-    std::string result = lines.front();
+    return std::optional(source);
+}
+
+StringCodeProvider::StringCodeProvider(std::vector<std::string> _lines, bool addLineBreaks) : lines(std::move(_lines)) {
     if (addLineBreaks) {
-        result += "\n";
+        for (auto &line : lines) {
+            line += "\n";
+        }
     }
-    lines.erase(lines.begin());
-    return std::optional(result);
 }
 
-std::string removeLeadingWhitespace(const std::string &str) {
-    std::string result = str;
-    while (!result.empty() && (result[0] == ' ' || result[0] == '\t')) {
-        result = result.substr(1, result.length());
+std::optional<std::string_view> StringCodeProvider::getMoreCode() {
+    if (currentLine >= lines.size()) {
+        return {};
     }
-    return result;
+    return std::optional<std::string_view>(lines[currentLine++]);
 }
 
 Token Lexer::getToken() {
-    std::string previousWord = currentWord;
+    std::string_view previousWord = currentWord;
     while (true) {
         if (currentWord.empty()) {
             auto optionalCode = codeProvider->getMoreCode();
@@ -81,55 +141,16 @@ Token Lexer::getToken() {
             }
         }
 
-        currentWord = removeLeadingWhitespace(currentWord);
-        log.debug("Current word: '" + currentWord + "'");
-
-        auto floatToken = matchRegex("^[0-9]+\\.[0-9]+", Token::FLOAT);
-        if (floatToken.has_value()) {
-            currentWord = currentWord.substr(floatToken.value().content.length(), currentWord.length() - 1);
-            return floatToken.value();
-        }
-
-        auto intToken = matchRegex("^[0-9]+", Token::INTEGER);
-        if (intToken.has_value()) {
-            currentWord = currentWord.substr(intToken.value().content.length(), currentWord.length() - 1);
-            return intToken.value();
-        }
-
-        auto stringToken = matchRegex("^\".*\"", Token::STRING);
-        if (stringToken.has_value()) {
-            currentWord = currentWord.substr(stringToken.value().content.length(), currentWord.length() - 1);
-            return stringToken.value();
-        }
-
-        auto commentToken = matchRegex("^#.*(\\n|$)", Token::COMMENT);
-        if (commentToken.has_value()) {
-            currentWord = currentWord.substr(commentToken.value().content.length(), currentWord.length() - 1);
-            return commentToken.value();
-        }
-
-        auto wordToken = matchWordToken();
-        if (wordToken.has_value()) {
-            currentWord = currentWord.substr(wordToken.value().content.length(), currentWord.length() - 1);
-            return wordToken.value();
-        }
-
-        auto twoCharToken = matchTwoCharToken();
-        if (twoCharToken.has_value()) {
-            currentWord = currentWord.substr(2, currentWord.length() - 1);
-            return twoCharToken.value();
-        }
-
-        auto oneCharToken = matchOneCharToken();
-        if (oneCharToken.has_value()) {
-            currentWord = currentWord.substr(1, currentWord.length() - 1);
-            return oneCharToken.value();
-        }
+        currentWord.remove_prefix(skipWhitespace(currentWord, 0));
+        LOG_DEBUG(log, "Current word: '" + std::string(currentWord.substr(0, currentWord.find('\n'))) + "'");
 
-        auto variableNameToken = matchRegex("^[a-zA-Z_][_a-zA-Z0-9]*", Token::IDENTIFIER);
-        if (variableNameToken.has_value()) {
-            currentWord = currentWord.substr(variableNameToken.value().content.length(), currentWord.length() - 1);
-            return variableNameToken.value();
+        auto token = matchToken();
+        if (token.has_value()) {
+            // operators are matched against literals, make them point into the source as well
+            const auto length = token.value().content.length();
+            token.value().content = currentWord.substr(0, length);
+            currentWord.remove_prefix(length);
+            return token.value();
         }
 
         if (currentWord == previousWord) {
@@ -138,90 +159,95 @@ Token Lexer::getToken() {
         previousWord = currentWord;
     }
 
-    std::string invalidToken;
-    auto nextSpace = currentWord.find(' ');
-    if (nextSpace == std::string::npos) {
+    // an invalid token reaches up to the next space or up to and including the next line break
+    std::string_view invalidToken;
+    auto end = currentWord.find_first_of(" \n");
+    if (end == std::string_view::npos) {
         invalidToken = currentWord;
-        currentWord = "";
+        currentWord = {};
+    } else if (currentWord[end] == ' ') {
+        invalidToken = currentWord.substr(0, end);
+        currentWord.remove_prefix(end + 1);
     } else {
-        invalidToken = currentWord.substr(0, nextSpace);
-        currentWord = currentWord.substr(nextSpace + 1, currentWord.length() - 1);
+        invalidToken = currentWord.substr(0, end + 1);
+        currentWord.remove_prefix(end + 1);
     }
 
     if (!invalidToken.empty()) {
-        log.debug("Found an invalid token: '" + invalidToken + "'");
+        LOG_DEBUG(log, "Found an invalid token: '" + std::string(invalidToken) + "'");
     }
     return {Token::INVALID, invalidToken};
 }
 
-std::optional<Token> Lexer::matchRegex(const std::string &regex, Token::TokenType tokenType) {
-    std::regex re(regex);
-    auto itr = std::sregex_iterator(currentWord.begin(), currentWord.end(), re);
-    if (itr != std::sregex_iterator()) {
-        auto content = static_cast<std::string>((*itr).str());
-        Token token = {tokenType, content};
-        return std::optional<Token>(token);
+std::optional<Token> Lexer::matchToken() {
+    if (currentWord.empty()) {
+        return {};
     }
-    return {};
-}
 
-std::optional<Token> Lexer::matchWordToken() {
-    if (STARTS_WITH(currentWord, "true")) {
-        return TOKEN(Token::BOOLEAN, "true");
-    }
-    if (STARTS_WITH(currentWord, "false")) {
-        return TOKEN(Token::BOOLEAN, "false");
-    }
-    if (STARTS_WITH(currentWord, "not")) {
-        return TOKEN(Token::NOT, "not");
-    }
-    if (STARTS_WITH(currentWord, "and")) {
-        return TOKEN(Token::AND, "and");
-    }
-    if (STARTS_WITH(currentWord, "or")) {
-        return TOKEN(Token::OR, "or");
-    }
-    if (STARTS_WITH(currentWord, "fun")) {
-        return TOKEN(Token::FUN, "fun");
+    // the first character decides which kind of token we are looking at, so that every token is scanned only once
+    const char firstChar = currentWord[0];
+    if (hasClass(firstChar, CharacterClass::DIGIT)) {
+        return matchNumber();
     }
-    if (STARTS_WITH(currentWord, "type")) {
-        return TOKEN(Token::TYPE, "type");
+    if (firstChar == '"') {
+        return matchString();
     }
-    if (STARTS_WITH(currentWord, "int")) {
-        return TOKEN(Token::SIMPLE_DATA_TYPE, "int");
+    if (firstChar == '#') {
+        return matchComment();
     }
-    if (STARTS_WITH(currentWord, "float")) {
-        return TOKEN(Token::SIMPLE_DATA_TYPE, "float");
+    if (hasClass(firstChar, CharacterClass::IDENTIFIER_START)) {
+        return matchIdentifier();
     }
-    if (STARTS_WITH(currentWord, "bool")) {
-        return TOKEN(Token::SIMPLE_DATA_TYPE, "bool");
-    }
-    if (STARTS_WITH(currentWord, "string")) {
-        return TOKEN(Token::SIMPLE_DATA_TYPE, "string");
-    }
-    if (STARTS_WITH(currentWord, "return")) {
-        return TOKEN(Token::RETURN, "return");
-    }
-    if (STARTS_WITH(currentWord, "extern")) {
-        return TOKEN(Token::EXTERN, "extern");
-    }
-    if (STARTS_WITH(currentWord, "if")) {
-        return TOKEN(Token::IF, "if");
-    }
-    if (STARTS_WITH(currentWord, "else")) {
-        return TOKEN(Token::ELSE, "else");
+
+    auto twoCharToken = matchTwoCharToken();
+    if (twoCharToken.has_value()) {
+        return twoCharToken;
     }
-    if (STARTS_WITH(currentWord, "for")) {
-        return TOKEN(Token::FOR, "for");
+    return matchOneCharToken();
+}
+
+std::optional<Token> Lexer::matchNumber() {
+    // [0-9]+ or [0-9]+\.[0-9]+
+    size_t end = skipDigits(currentWord, 0);
+    if (end + 1 < currentWord.size() && currentWord[end] == '.' &&
+        hasClass(currentWord[end + 1], CharacterClass::DIGIT)) {
+        end = skipDigits(currentWord, end + 1);
+        return TOKEN(Token::FLOAT, currentWord.substr(0, end));
+    }
+    return TOKEN(Token::INTEGER, currentWord.substr(0, end));
+}
+
+std::optional<Token> Lexer::matchString() {
+    // a string reaches up to the last quote in the current line
+    const size_t lineEnd = findLineTerminator(currentWord, 1);
+    const size_t lastQuote = currentWord.substr(0, lineEnd).rfind('"');
+    if (lastQuote == 0) {
+        return {};
     }
-    if (STARTS_WITH(currentWord, "import")) {
-        return TOKEN(Token::IMPORT, "import");
+    return TOKEN(Token::STRING, currentWord.substr(0, lastQuote + 1));
+}
+
+std::optional<Token> Lexer::matchComment() {
+    // a comment reaches up to and including the next line break or up to the end of the input
+    const size_t end = findLineTerminator(currentWord, 1);
+    if (end == currentWord.size()) {
+        return TOKEN(Token::COMMENT, currentWord);
     }
-    if (STARTS_WITH(currentWord, "assert")) {
-        return TOKEN(Token::ASSERT, "assert");
+    if (currentWord[end] != '\n') {
+        return {};
     }
+    return TOKEN(Token::COMMENT, currentWord.substr(0, end + 1));
+}
 
-    return {};
+std::optional<Token> Lexer::matchIdentifier() {
+    // [a-zA-Z_][_a-zA-Z0-9]*, keywords are only recognized as whole words
+    size_t end = skipIdentifierPart(currentWord, 1);
+    auto word = currentWord.substr(0, end);
+    const auto type = classifyWord(word);
+    if (type != Token::IDENTIFIER) {
+        return TOKEN(type, word);
+    }
+    return std::optional<Token>({Token::IDENTIFIER, word, symbolTable.intern(word)});
 }
 
 std::optional<Token> Lexer::matchTwoCharToken() {
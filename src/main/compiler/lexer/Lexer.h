@@ -1,8 +1,8 @@
 #pragma once
 
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <filesystem>
@@ -14,38 +14,48 @@ class CodeProvider {
   public:
     virtual ~CodeProvider() = default;
 
-    virtual std::optional<std::string> getMoreCode() = 0;
+    // NOTE the returned code has to stay valid as long as the provider exists, since tokens point into it
+    virtual std::optional<std::string_view> getMoreCode() = 0;
 };
 
 class FileCodeProvider : public CodeProvider {
   public:
     explicit FileCodeProvider(std::filesystem::path absoluteFilePath) : fileName(std::move(absoluteFilePath)) {}
+    ~FileCodeProvider() override;
+    FileCodeProvider(const FileCodeProvider &) = delete;
+    FileCodeProvider &operator=(const FileCodeProvider &) = delete;
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
 
   private:
     const std::filesystem::path fileName;
     bool fileHasBeenRead = false;
-    std::vector<std::string> lines = {};
+    // NOTE points either into the memory mapped file or into readBuffer
+    std::string_view source = {};
+    void *mappedData = nullptr;
+    size_t mappedSize = 0;
+    std::string readBuffer;
+
+    bool mapFile();
+    void readFile();
 };
 
 class StringCodeProvider : public CodeProvider {
   public:
-    explicit StringCodeProvider(std::vector<std::string> lines, bool addLineBreaks)
-        : lines(std::move(lines)), addLineBreaks(addLineBreaks) {}
+    explicit StringCodeProvider(std::vector<std::string> lines, bool addLineBreaks);
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
 
   private:
     std::vector<std::string> lines = {};
-    bool addLineBreaks = false;
+    size_t currentLine = 0;
 };
 
 class ByteCodeProvider : public CodeProvider {
   public:
     explicit ByteCodeProvider(const char *data, const long size) : data(data), size(size) {}
 
-    std::optional<std::string> getMoreCode() override;
+    std::optional<std::string_view> getMoreCode() override;
 
   private:
     const char *data;
@@ -54,17 +64,22 @@ class ByteCodeProvider : public CodeProvider {
 
 class Lexer {
   public:
-    explicit Lexer(CodeProvider *codeProvider, const Logger &logger) : codeProvider(codeProvider), log(logger){};
+    explicit Lexer(CodeProvider *codeProvider, SymbolTable &symbolTable, const Logger &logger)
+        : codeProvider(codeProvider), symbolTable(symbolTable), log(logger){};
 
     Token getToken();
 
   private:
-    std::string currentWord;
+    std::string_view currentWord;
     CodeProvider *codeProvider;
+    SymbolTable &symbolTable;
     const Logger &log;
 
-    std::optional<Token> matchRegex(const std::string &regex, Token::TokenType tokenType);
+    std::optional<Token> matchToken();
+    std::optional<Token> matchNumber();
+    std::optional<Token> matchString();
+    std::optional<Token> matchComment();
+    std::optional<Token> matchIdentifier();
     std::optional<Token> matchOneCharToken();
     std::optional<Token> matchTwoCharToken();
-    std::optional<Token> matchWordToken();
 };
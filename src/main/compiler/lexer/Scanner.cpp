@@ -0,0 +1,237 @@
+#include "Scanner.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NEON_SCANNER_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if NEON_SCANNER_SSE2 && defined(__GNUC__)
+// NOTE AVX2 code is compiled with a target attribute and only executed after checking the CPU at runtime
+#define NEON_SCANNER_AVX2 1
+#define NEON_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+// Every kernel runs from position as long as the characters belong to characterClass (skip = true) or as long as they
+// don't belong to it (skip = false).
+
+template <CharacterClass characterClass, bool skip> size_t scanScalar(std::string_view str, size_t position) {
+    while (position < str.size() && hasClass(str[position], characterClass) == skip) {
+        position++;
+    }
+    return position;
+}
+
+#if NEON_SCANNER_SSE2
+inline __m128i inRangeSse2(__m128i chars, char low, char high) {
+    // NOTE the comparisons are signed, but all bounds are ASCII, so bytes >= 0x80 are never in range
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(low - 1))),
+                         _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(high + 1))));
+}
+
+inline __m128i equalsSse2(__m128i chars, char c) { return _mm_cmpeq_epi8(chars, _mm_set1_epi8(c)); }
+
+template <CharacterClass characterClass> __m128i classifySse2(__m128i chars) {
+    if constexpr (characterClass == CharacterClass::BLANK) {
+        return _mm_or_si128(equalsSse2(chars, ' '), equalsSse2(chars, '\t'));
+    } else if constexpr (characterClass == CharacterClass::DIGIT) {
+        return inRangeSse2(chars, '0', '9');
+    } else if constexpr (characterClass == CharacterClass::IDENTIFIER_PART) {
+        // setting bit 5 maps upper case letters onto lower case letters
+        const auto letters = inRangeSse2(_mm_or_si128(chars, _mm_set1_epi8(0x20)), 'a', 'z');
+        return _mm_or_si128(_mm_or_si128(letters, inRangeSse2(chars, '0', '9')), equalsSse2(chars, '_'));
+    } else {
+        static_assert(characterClass == CharacterClass::LINE_TERMINATOR);
+        return _mm_or_si128(equalsSse2(chars, '\n'), equalsSse2(chars, '\r'));
+    }
+}
+
+template <CharacterClass characterClass, bool skip> size_t scanSse2(std::string_view str, size_t position) {
+    const size_t blockSize = 16;
+    while (position + blockSize <= str.size()) {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str.data() + position));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(classifySse2<characterClass>(chars)));
+        if (skip) {
+            mask = ~mask & 0xFFFFU;
+        }
+        if (mask != 0) {
+            return position + std::countr_zero(mask);
+        }
+        position += blockSize;
+    }
+    return scanScalar<characterClass, skip>(str, position);
+}
+#endif
+
+#if NEON_SCANNER_AVX2
+NEON_TARGET_AVX2 inline __m256i inRangeAvx2(__m256i chars, char low, char high) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(low - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(high + 1)), chars));
+}
+
+NEON_TARGET_AVX2 inline __m256i equalsAvx2(__m256i chars, char c) {
+    return _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c));
+}
+
+template <CharacterClass characterClass> NEON_TARGET_AVX2 __m256i classifyAvx2(__m256i chars) {
+    if constexpr (characterClass == CharacterClass::BLANK) {
+        return _mm256_or_si256(equalsAvx2(chars, ' '), equalsAvx2(chars, '\t'));
+    } else if constexpr (characterClass == CharacterClass::DIGIT) {
+        return inRangeAvx2(chars, '0', '9');
+    } else if constexpr (characterClass == CharacterClass::IDENTIFIER_PART) {
+        const auto letters = inRangeAvx2(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), 'a', 'z');
+        return _mm256_or_si256(_mm256_or_si256(letters, inRangeAvx2(chars, '0', '9')), equalsAvx2(chars, '_'));
+    } else {
+        static_assert(characterClass == CharacterClass::LINE_TERMINATOR);
+        return _mm256_or_si256(equalsAvx2(chars, '\n'), equalsAvx2(chars, '\r'));
+    }
+}
+
+template <CharacterClass characterClass, bool skip>
+NEON_TARGET_AVX2 size_t scanAvx2(std::string_view str, size_t position) {
+    const size_t blockSize = 32;
+    while (position + blockSize <= str.size()) {
+        const auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str.data() + position));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(classifyAvx2<characterClass>(chars)));
+        if (skip) {
+            mask = ~mask;
+        }
+        if (mask != 0) {
+            return position + std::countr_zero(mask);
+        }
+        position += blockSize;
+    }
+    // NOTE not falling back to the SSE2 kernel, mixing legacy SSE and AVX instructions is expensive
+    return scanScalar<characterClass, skip>(str, position);
+}
+#endif
+
+struct ScannerKernels {
+    size_t (*skipWhitespace)(std::string_view, size_t);
+    size_t (*skipDigits)(std::string_view, size_t);
+    size_t (*skipIdentifierPart)(std::string_view, size_t);
+    size_t (*findLineTerminator)(std::string_view, size_t);
+};
+
+#define SCANNER_KERNELS(scan)                                                                                          \
+    ScannerKernels {                                                                                                   \
+        scan<CharacterClass::BLANK, true>, scan<CharacterClass::DIGIT, true>,                                          \
+              scan<CharacterClass::IDENTIFIER_PART, true>, scan<CharacterClass::LINE_TERMINATOR, false>,               \
+    }
+
+const ScannerKernels SCALAR_KERNELS = SCANNER_KERNELS(scanScalar);
+#if NEON_SCANNER_SSE2
+const ScannerKernels SSE2_KERNELS = SCANNER_KERNELS(scanSse2);
+#endif
+#if NEON_SCANNER_AVX2
+const ScannerKernels AVX2_KERNELS = SCANNER_KERNELS(scanAvx2);
+#endif
+
+const ScannerKernels &getKernels(ScannerImplementation implementation) {
+    switch (implementation) {
+#if NEON_SCANNER_AVX2
+    case ScannerImplementation::AVX2:
+        return AVX2_KERNELS;
+#endif
+#if NEON_SCANNER_SSE2
+    case ScannerImplementation::SSE2:
+        return SSE2_KERNELS;
+#endif
+    default:
+        return SCALAR_KERNELS;
+    }
+}
+
+ScannerImplementation detectScannerImplementation() {
+    if (isSupported(ScannerImplementation::AVX2)) {
+        return ScannerImplementation::AVX2;
+    }
+    if (isSupported(ScannerImplementation::SSE2)) {
+        return ScannerImplementation::SSE2;
+    }
+    return ScannerImplementation::SCALAR;
+}
+
+ScannerImplementation activeImplementation = detectScannerImplementation();
+const ScannerKernels *activeKernels = &getKernels(activeImplementation);
+
+// most runs (single spaces, identifiers, numbers) are short, finishing them without a vector load is faster
+const size_t SCALAR_PREFIX_LENGTH = 16;
+
+template <CharacterClass characterClass, bool skip>
+size_t scan(std::string_view str, size_t position, size_t (*kernel)(std::string_view, size_t)) {
+    const size_t prefixEnd = std::min(str.size(), position + SCALAR_PREFIX_LENGTH);
+    while (position < prefixEnd && hasClass(str[position], characterClass) == skip) {
+        position++;
+    }
+    if (position < prefixEnd || position == str.size()) {
+        return position;
+    }
+    return kernel(str, position);
+}
+
+} // namespace
+
+std::string to_string(ScannerImplementation implementation) {
+    switch (implementation) {
+    case ScannerImplementation::SCALAR:
+        return "SCALAR";
+    case ScannerImplementation::SSE2:
+        return "SSE2";
+    case ScannerImplementation::AVX2:
+        return "AVX2";
+    }
+    return "UNKNOWN";
+}
+
+bool isSupported(ScannerImplementation implementation) {
+    switch (implementation) {
+    case ScannerImplementation::SCALAR:
+        return true;
+    case ScannerImplementation::SSE2:
+#if NEON_SCANNER_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case ScannerImplementation::AVX2:
+#if NEON_SCANNER_AVX2
+        // NOTE this might run during static initialization, before the runtime initialized the cpu model itself
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+void setScannerImplementation(ScannerImplementation implementation) {
+    if (!isSupported(implementation)) {
+        return;
+    }
+    activeImplementation = implementation;
+    activeKernels = &getKernels(implementation);
+}
+
+ScannerImplementation getScannerImplementation() { return activeImplementation; }
+
+size_t skipWhitespace(std::string_view str, size_t position) {
+    return scan<CharacterClass::BLANK, true>(str, position, activeKernels->skipWhitespace);
+}
+
+size_t skipDigits(std::string_view str, size_t position) {
+    return scan<CharacterClass::DIGIT, true>(str, position, activeKernels->skipDigits);
+}
+
+size_t skipIdentifierPart(std::string_view str, size_t position) {
+    return scan<CharacterClass::IDENTIFIER_PART, true>(str, position, activeKernels->skipIdentifierPart);
+}
+
+size_t findLineTerminator(std::string_view str, size_t position) {
+    return scan<CharacterClass::LINE_TERMINATOR, false>(str, position, activeKernels->findLineTerminator);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+enum class CharacterClass : uint8_t {
+    DIGIT = 1U << 0U,
+    IDENTIFIER_START = 1U << 1U,
+    IDENTIFIER_PART = 1U << 2U,
+    LINE_TERMINATOR = 1U << 3U,
+    BLANK = 1U << 4U,
+};
+
+// a character can have multiple classes, the entries of the character table are the combined bits
+constexpr uint8_t operator|(CharacterClass lhs, CharacterClass rhs) {
+    return static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs);
+}
+
+constexpr std::array<uint8_t, 256> createCharacterTable() {
+    std::array<uint8_t, 256> table = {};
+    for (int c = '0'; c <= '9'; c++) {
+        table[c] = CharacterClass::DIGIT | CharacterClass::IDENTIFIER_PART;
+    }
+    for (int c = 'a'; c <= 'z'; c++) {
+        table[c] = CharacterClass::IDENTIFIER_START | CharacterClass::IDENTIFIER_PART;
+    }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        table[c] = CharacterClass::IDENTIFIER_START | CharacterClass::IDENTIFIER_PART;
+    }
+    table['_'] = CharacterClass::IDENTIFIER_START | CharacterClass::IDENTIFIER_PART;
+    table['\n'] = static_cast<uint8_t>(CharacterClass::LINE_TERMINATOR);
+    table['\r'] = static_cast<uint8_t>(CharacterClass::LINE_TERMINATOR);
+    table[' '] = static_cast<uint8_t>(CharacterClass::BLANK);
+    table['\t'] = static_cast<uint8_t>(CharacterClass::BLANK);
+    return table;
+}
+
+// NOTE the table is computed at compile time, classifying a character is a single lookup
+constexpr std::array<uint8_t, 256> CHARACTER_TABLE = createCharacterTable();
+
+inline bool hasClass(char c, CharacterClass characterClass) {
+    return (CHARACTER_TABLE[static_cast<unsigned char>(c)] & static_cast<uint8_t>(characterClass)) != 0;
+}
+
+enum class ScannerImplementation { SCALAR, SSE2, AVX2 };
+
+std::string to_string(ScannerImplementation implementation);
+
+bool isSupported(ScannerImplementation implementation);
+
+// the best supported implementation is selected at startup, this is only meant to be used by tests and benchmarks
+void setScannerImplementation(ScannerImplementation implementation);
+ScannerImplementation getScannerImplementation();
+
+// The following functions look at str starting from position and return the position of the first character that
+// does not match, or str.size() if all remaining characters match.
+
+// skips spaces and tabs
+size_t skipWhitespace(std::string_view str, size_t position);
+// skips [0-9]
+size_t skipDigits(std::string_view str, size_t position);
+// skips [_a-zA-Z0-9]
+size_t skipIdentifierPart(std::string_view str, size_t position);
+// skips everything up to the next '\n' or '\r'
+size_t findLineTerminator(std::string_view str, size_t position);
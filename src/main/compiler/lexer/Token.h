@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
+
+#include "../SymbolTable.h"
 
 struct Token {
     enum TokenType {
@@ -49,7 +53,86 @@ struct Token {
     };
 
     TokenType type;
-    std::string content;
+    // NOTE points into the source buffer of the code provider that produced the token
+    std::string_view content;
+    // only set for identifiers
+    Symbol symbol = 0;
 };
 
 std::string to_string(Token::TokenType type);
+
+struct Keyword {
+    std::string_view word;
+    Token::TokenType type;
+};
+
+constexpr std::array<Keyword, 18> KEYWORDS = {{
+      {"true", Token::BOOLEAN},
+      {"false", Token::BOOLEAN},
+      {"not", Token::NOT},
+      {"and", Token::AND},
+      {"or", Token::OR},
+      {"fun", Token::FUN},
+      {"type", Token::TYPE},
+      {"int", Token::SIMPLE_DATA_TYPE},
+      {"float", Token::SIMPLE_DATA_TYPE},
+      {"bool", Token::SIMPLE_DATA_TYPE},
+      {"string", Token::SIMPLE_DATA_TYPE},
+      {"return", Token::RETURN},
+      {"extern", Token::EXTERN},
+      {"if", Token::IF},
+      {"else", Token::ELSE},
+      {"for", Token::FOR},
+      {"import", Token::IMPORT},
+      {"assert", Token::ASSERT},
+}};
+
+constexpr size_t KEYWORD_MIN_LENGTH = 2;
+constexpr size_t KEYWORD_MAX_LENGTH = 6;
+constexpr size_t KEYWORD_TABLE_SIZE = 32;
+
+constexpr size_t keywordHash(std::string_view word) {
+    // NOTE the factors have been chosen so that every keyword ends up in its own slot
+    const auto first = static_cast<unsigned char>(word[0]);
+    const auto second = static_cast<unsigned char>(word[1]);
+    const auto last = static_cast<unsigned char>(word.back());
+    return (word.size() * 3 + first * 3 + second + last * 7) % KEYWORD_TABLE_SIZE;
+}
+
+constexpr std::array<int, KEYWORD_TABLE_SIZE> createKeywordTable() {
+    std::array<int, KEYWORD_TABLE_SIZE> table = {};
+    table.fill(-1);
+    for (size_t i = 0; i < KEYWORDS.size(); i++) {
+        table[keywordHash(KEYWORDS[i].word)] = static_cast<int>(i);
+    }
+    return table;
+}
+
+constexpr std::array<int, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = createKeywordTable();
+
+constexpr bool keywordHashIsPerfect() {
+    for (size_t i = 0; i < KEYWORDS.size(); i++) {
+        const auto &word = KEYWORDS[i].word;
+        if (word.size() < KEYWORD_MIN_LENGTH || word.size() > KEYWORD_MAX_LENGTH) {
+            return false;
+        }
+        if (KEYWORD_TABLE[keywordHash(word)] != static_cast<int>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(keywordHashIsPerfect(), "Keywords collide in the keyword table, keywordHash needs different factors.");
+
+// returns the keyword type of a completely scanned word or IDENTIFIER if the word is not a keyword
+constexpr Token::TokenType classifyWord(std::string_view word) {
+    if (word.size() < KEYWORD_MIN_LENGTH || word.size() > KEYWORD_MAX_LENGTH) {
+        return Token::IDENTIFIER;
+    }
+    const int index = KEYWORD_TABLE[keywordHash(word)];
+    if (index == -1 || KEYWORDS[index].word != word) {
+        return Token::IDENTIFIER;
+    }
+    return KEYWORDS[index].type;
+}
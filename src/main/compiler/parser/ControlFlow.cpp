@@ -5,7 +5,7 @@ IfStatementNode *Parser::parseIf(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing if statement");
+    LOG_DEBUG(log, indent(level) + "parsing if statement");
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
@@ -40,7 +40,7 @@ ForStatementNode *Parser::parseFor(int level) {
     if (!currentTokenIs(Token::FOR)) {
         return nullptr;
     }
-    log.debug(indent(level) + "parsing for statement");
+    LOG_DEBUG(log, indent(level) + "parsing for statement");
 
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
@@ -91,7 +91,7 @@ StatementNode *Parser::parseReturnStatement(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing return statement");
+    LOG_DEBUG(log, indent(level) + "parsing return statement");
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
 
@@ -1,12 +1,10 @@
 #include "Parser.h"
 
-MemberAccessNode *Parser::parseMemberAccess(int level) {
+#include <array>
+
+MemberAccessNode *Parser::parseMemberAccess(AstNode *left, int level) {
     auto beforeTokenIdx = currentTokenIdx;
-    auto *lastNode = AST_NODE(parseVariable(level + 1));
-    if (lastNode == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
+    auto *lastNode = left;
 
     bool foundAtLeastOneDot = false;
     while (true) {
@@ -34,21 +32,30 @@ MemberAccessNode *Parser::parseMemberAccess(int level) {
     return &lastNode->member_access;
 }
 
-AstNode *Parser::parsePrimary(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *memberAccess = parseMemberAccess(level + 1);
-    if (memberAccess != nullptr) {
-        return AST_NODE(memberAccess);
+AstNode *Parser::parseVariableOrMemberAccess(int level) {
+    auto *variable = AST_NODE(parseVariable(level + 1));
+    if (variable == nullptr || !currentTokenIs(Token::DOT)) {
+        return variable;
     }
 
-    auto *functionCall = parseFunctionCall(level + 1);
-    if (functionCall != nullptr) {
-        return AST_NODE(functionCall);
+    // if the member access is incomplete, the variable on its own is used
+    auto *memberAccess = parseMemberAccess(variable, level + 1);
+    if (memberAccess == nullptr) {
+        return variable;
     }
+    return AST_NODE(memberAccess);
+}
 
-    auto *variable = parseVariable(level + 1);
-    if (variable != nullptr) {
-        return AST_NODE(variable);
+AstNode *Parser::parsePrimary(int level) {
+    auto beforeTokenIdx = currentTokenIdx;
+    if (currentTokenIs(Token::IDENTIFIER)) {
+        if (nextTokenIs(Token::LEFT_PARAN)) {
+            auto *functionCall = parseFunctionCall(level + 1);
+            if (functionCall != nullptr) {
+                return AST_NODE(functionCall);
+            }
+        }
+        return parseVariableOrMemberAccess(level + 1);
     }
 
     auto *literal = parseLiteral(level + 1);
@@ -101,167 +108,75 @@ AstNode *Parser::parseUnary(int level) {
     return AST_NODE(tree.createUnaryOperation(operationType, child));
 }
 
-AstNode *Parser::parseFactor(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastUnary = parseUnary(level + 1);
-    if (lastUnary == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::STAR)) {
-            operationType = ast::BinaryOperationType::MULTIPLICATION;
-        } else if (currentTokenIs(Token::DIV)) {
-            operationType = ast::BinaryOperationType::DIVISION;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseUnary(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastUnary = AST_NODE(tree.createBinaryOperation(operationType, lastUnary, other));
-    }
-
-    return lastUnary;
+namespace {
+
+enum class Associativity { LEFT, RIGHT };
+
+struct BinaryOperator {
+    // operators with a precedence of 0 are not binary operators
+    int precedence = 0;
+    Associativity associativity = Associativity::LEFT;
+    ast::BinaryOperationType type = ast::BinaryOperationType::ADDITION;
+};
+
+const int LOWEST_PRECEDENCE = 1;
+
+constexpr std::array<BinaryOperator, Token::END_OF_FILE + 1> createBinaryOperators() {
+    std::array<BinaryOperator, Token::END_OF_FILE + 1> result = {};
+    result[Token::AND] = {1, Associativity::LEFT, ast::BinaryOperationType::AND};
+    result[Token::OR] = {1, Associativity::LEFT, ast::BinaryOperationType::OR};
+    result[Token::DOUBLE_EQUALS] = {2, Associativity::LEFT, ast::BinaryOperationType::EQUALS};
+    result[Token::NOT_EQUALS] = {2, Associativity::LEFT, ast::BinaryOperationType::NOT_EQUALS};
+    result[Token::LESS_THAN] = {3, Associativity::LEFT, ast::BinaryOperationType::LESS_THAN};
+    result[Token::LESS_EQUALS] = {3, Associativity::LEFT, ast::BinaryOperationType::LESS_EQUALS};
+    result[Token::GREATER_THAN] = {3, Associativity::LEFT, ast::BinaryOperationType::GREATER_THAN};
+    result[Token::GREATER_EQUALS] = {3, Associativity::LEFT, ast::BinaryOperationType::GREATER_EQUALS};
+    result[Token::PLUS] = {4, Associativity::LEFT, ast::BinaryOperationType::ADDITION};
+    result[Token::MINUS] = {4, Associativity::LEFT, ast::BinaryOperationType::SUBTRACTION};
+    result[Token::STAR] = {5, Associativity::LEFT, ast::BinaryOperationType::MULTIPLICATION};
+    result[Token::DIV] = {5, Associativity::LEFT, ast::BinaryOperationType::DIVISION};
+    return result;
 }
 
-AstNode *Parser::parseTerm(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastFactor = parseFactor(level + 1);
-    if (lastFactor == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
+constexpr std::array<BinaryOperator, Token::END_OF_FILE + 1> BINARY_OPERATORS = createBinaryOperators();
 
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::PLUS)) {
-            operationType = ast::BinaryOperationType::ADDITION;
-        } else if (currentTokenIs(Token::MINUS)) {
-            operationType = ast::BinaryOperationType::SUBTRACTION;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseFactor(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
+} // namespace
 
-        lastFactor = AST_NODE(tree.createBinaryOperation(operationType, lastFactor, other));
-    }
-
-    return lastFactor;
-}
-
-AstNode *Parser::parseComparison(int level) {
+AstNode *Parser::parseBinaryOperation(int level, int minimumPrecedence) {
     auto beforeTokenIdx = currentTokenIdx;
-    auto *lastTerm = parseTerm(level + 1);
-    if (lastTerm == nullptr) {
+    auto *left = parseUnary(level + 1);
+    if (left == nullptr) {
         currentTokenIdx = beforeTokenIdx;
         return nullptr;
     }
 
+    // NOTE precedence climbing: the right hand side only takes operators that bind tighter than the current one, which
+    // makes all operators of the same precedence left associative
     while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::LESS_THAN)) {
-            operationType = ast::BinaryOperationType::LESS_THAN;
-        } else if (currentTokenIs(Token::LESS_EQUALS)) {
-            operationType = ast::BinaryOperationType::LESS_EQUALS;
-        } else if (currentTokenIs(Token::GREATER_THAN)) {
-            operationType = ast::BinaryOperationType::GREATER_THAN;
-        } else if (currentTokenIs(Token::GREATER_EQUALS)) {
-            operationType = ast::BinaryOperationType::GREATER_EQUALS;
-        } else {
+        if (!tokens->has(currentTokenIdx)) {
             break;
         }
-
-        currentTokenIdx++;
-
-        auto *other = parseTerm(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastTerm = AST_NODE(tree.createBinaryOperation(operationType, lastTerm, other));
-    }
-
-    return lastTerm;
-}
-
-AstNode *Parser::parseEquality(int level) {
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastComparison = parseComparison(level + 1);
-    if (lastComparison == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::DOUBLE_EQUALS)) {
-            operationType = ast::BinaryOperationType::EQUALS;
-        } else if (currentTokenIs(Token::NOT_EQUALS)) {
-            operationType = ast::BinaryOperationType::NOT_EQUALS;
-        } else {
+        const auto &op = BINARY_OPERATORS[tokens->at(currentTokenIdx).type];
+        if (op.precedence < minimumPrecedence) {
             break;
         }
 
         currentTokenIdx++;
 
-        auto *other = parseComparison(level + 1);
-        if (other == nullptr) {
+        const int nextPrecedence = op.associativity == Associativity::LEFT ? op.precedence + 1 : op.precedence;
+        auto *right = parseBinaryOperation(level + 1, nextPrecedence);
+        if (right == nullptr) {
             currentTokenIdx = beforeTokenIdx;
             return nullptr;
         }
 
-        lastComparison = AST_NODE(tree.createBinaryOperation(operationType, lastComparison, other));
+        left = AST_NODE(tree.createBinaryOperation(op.type, left, right));
     }
 
-    return lastComparison;
+    return left;
 }
 
 AstNode *Parser::parseExpression(int level) {
-    log.debug(indent(level) + "parsing expression node");
-    auto beforeTokenIdx = currentTokenIdx;
-    auto *lastEquality = parseEquality(level + 1);
-    if (lastEquality == nullptr) {
-        currentTokenIdx = beforeTokenIdx;
-        return nullptr;
-    }
-
-    while (true) {
-        ast::BinaryOperationType operationType;
-        if (currentTokenIs(Token::AND)) {
-            operationType = ast::BinaryOperationType::AND;
-        } else if (currentTokenIs(Token::OR)) {
-            operationType = ast::BinaryOperationType::OR;
-        } else {
-            break;
-        }
-
-        currentTokenIdx++;
-
-        auto *other = parseEquality(level + 1);
-        if (other == nullptr) {
-            currentTokenIdx = beforeTokenIdx;
-            return nullptr;
-        }
-
-        lastEquality = AST_NODE(tree.createBinaryOperation(operationType, lastEquality, other));
-    }
-
-    return lastEquality;
+    LOG_DEBUG(log, indent(level) + "parsing expression node");
+    return parseBinaryOperation(level + 1, LOWEST_PRECEDENCE);
 }
@@ -6,7 +6,7 @@ CallNode *Parser::parseFunctionCall(int level) {
     }
 
     auto beforeTokenIdx = currentTokenIdx;
-    std::string name = currentTokenContent();
+    auto name = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_PARAN)) {
@@ -16,7 +16,7 @@ CallNode *Parser::parseFunctionCall(int level) {
 
     currentTokenIdx++;
 
-    log.debug(indent(level) + "parsing call node");
+    LOG_DEBUG(log, indent(level) + "parsing call node");
 
     std::vector<AstNode *> params = {};
     while (!currentTokenIs(Token::RIGHT_PARAN)) {
@@ -59,9 +59,9 @@ FunctionNode *Parser::parseFunction(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing function node");
+    LOG_DEBUG(log, indent(level) + "parsing function node");
 
-    std::string functionName = currentTokenContent();
+    auto functionName = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_PARAN)) {
@@ -1,18 +1,30 @@
 #include "Parser.h"
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 
-Token Parser::getNextToken() {
-    Token token = lexer.getToken();
-    tokens.push_back(token);
-    return token;
+bool Parser::currentTokenIs(Token::TokenType tokenType) const {
+    return tokens->has(currentTokenIdx) && tokens->at(currentTokenIdx).type == tokenType;
 }
 
-bool Parser::currentTokenIs(Token::TokenType tokenType) const {
-    return currentTokenIdx < tokens.size() && tokens[currentTokenIdx].type == tokenType;
+bool Parser::nextTokenIs(Token::TokenType tokenType) const {
+    return tokens->has(currentTokenIdx + 1) && tokens->at(currentTokenIdx + 1).type == tokenType;
+}
+
+std::string_view Parser::currentTokenContent() const {
+    if (!tokens->has(currentTokenIdx)) {
+        return {};
+    }
+    return tokens->at(currentTokenIdx).content;
 }
 
-std::string Parser::currentTokenContent() const { return tokens[currentTokenIdx].content; }
+Symbol Parser::currentTokenSymbol() const {
+    if (!tokens->has(currentTokenIdx)) {
+        return 0;
+    }
+    return tokens->at(currentTokenIdx).symbol;
+}
 
 std::string Parser::indent(int level) {
     std::string result;
@@ -34,8 +46,7 @@ ImportNode *Parser::parseImport() {
         return nullptr;
     }
 
-    std::string fileName = currentTokenContent();
-    fileName = fileName.substr(1, fileName.size() - 2);
+    auto fileName = currentTokenContent().substr(1, currentTokenContent().size() - 2);
 
     currentTokenIdx++;
     return tree.createImport(fileName);
@@ -47,7 +58,7 @@ VariableNode *Parser::parseVariable(int level) {
     }
 
     auto beforeTokenIdx = currentTokenIdx;
-    std::string name = currentTokenContent();
+    auto name = currentTokenSymbol();
 
     currentTokenIdx++;
 
@@ -72,7 +83,7 @@ VariableNode *Parser::parseVariable(int level) {
 }
 
 VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
-    log.debug(indent(level) + "parsing variable definition node");
+    LOG_DEBUG(log, indent(level) + "parsing variable definition node");
 
     auto beforeTokenIdx = currentTokenIdx;
     if (currentTokenIs(Token::SIMPLE_DATA_TYPE)) {
@@ -81,8 +92,8 @@ VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
         currentTokenIdx++;
 
         if (currentTokenIs(Token::IDENTIFIER)) {
-            log.debug(indent(level) + "parsed variable definition with simple data type");
-            std::string variableName = currentTokenContent();
+            LOG_DEBUG(log, indent(level) + "parsed variable definition with simple data type");
+            auto variableName = currentTokenSymbol();
             currentTokenIdx++;
             return tree.createVariableDefinition(variableName, dataType, 0);
         }
@@ -107,10 +118,11 @@ VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
                 return nullptr;
             }
 
-            std::string variableName = currentTokenContent();
+            auto variableName = currentTokenSymbol();
             currentTokenIdx++;
             return tree.createVariableDefinition(variableName, dataType, literal->i);
         }
+        currentTokenIdx = beforeTokenIdx;
     } else if (currentTokenIs(Token::IDENTIFIER)) {
         auto dataType = ast::DataType(currentTokenContent());
 
@@ -121,13 +133,13 @@ VariableDefinitionNode *Parser::parseVariableDefinition(int level) {
             return nullptr;
         }
 
-        log.debug(indent(level) + "parsed variable definition with simple data type");
-        std::string variableName = currentTokenContent();
+        LOG_DEBUG(log, indent(level) + "parsed variable definition with simple data type");
+        auto variableName = currentTokenSymbol();
         currentTokenIdx++;
         return tree.createVariableDefinition(variableName, dataType, 0);
     }
 
-    log.debug(indent(level) + "failed to parse variable definition");
+    LOG_DEBUG(log, indent(level) + "failed to parse variable definition");
 
     return nullptr;
 }
@@ -136,7 +148,7 @@ SequenceNode *Parser::parseScope(int level) {
     if (!currentTokenIs(Token::LEFT_CURLY_BRACE)) {
         return nullptr;
     }
-    log.debug(indent(level) + "parsing scope");
+    LOG_DEBUG(log, indent(level) + "parsing scope");
 
     auto beforeTokenIdx = currentTokenIdx;
     currentTokenIdx++;
@@ -162,33 +174,23 @@ SequenceNode *Parser::parseScope(int level) {
 }
 
 AstNode *Parser::parseAssignmentLeft(int level) {
-    auto *variableDefinitionNode = parseVariableDefinition(level + 1);
-    if (variableDefinitionNode != nullptr) {
-        return AST_NODE(variableDefinitionNode);
-    }
-
-    auto *memberAccess = parseMemberAccess(level + 1);
-    if (memberAccess != nullptr) {
-        return AST_NODE(memberAccess);
-    }
-
-    auto *variableNode = parseVariable(level + 1);
-    if (variableNode != nullptr) {
-        return AST_NODE(variableNode);
+    const bool isSimpleDefinition = currentTokenIs(Token::SIMPLE_DATA_TYPE);
+    const bool isComplexDefinition = currentTokenIs(Token::IDENTIFIER) && nextTokenIs(Token::IDENTIFIER);
+    if (isSimpleDefinition || isComplexDefinition) {
+        return AST_NODE(parseVariableDefinition(level + 1));
     }
-
-    return nullptr;
+    return parseVariableOrMemberAccess(level + 1);
 }
 
 AssignmentNode *Parser::parseAssignment(int level) {
-    log.debug(indent(level) + "parsing assignment statement");
+    LOG_DEBUG(log, indent(level) + "parsing assignment statement");
     auto beforeTokenIdx = currentTokenIdx;
     auto *left = parseAssignmentLeft(level + 1);
     if (left == nullptr) {
         currentTokenIdx = beforeTokenIdx;
         return nullptr;
     }
-    log.debug(indent(level) + "parsed assignment left");
+    LOG_DEBUG(log, indent(level) + "parsed assignment left");
 
     if (!currentTokenIs(Token::SINGLE_EQUALS)) {
         currentTokenIdx = beforeTokenIdx;
@@ -202,17 +204,42 @@ AssignmentNode *Parser::parseAssignment(int level) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsed assignment right");
+    LOG_DEBUG(log, indent(level) + "parsed assignment right");
 
     return tree.createAssignment(left, right);
 }
 
+AstNode *Parser::parseVariableDefinitionStatement(int level) {
+    auto *variableDefinition = parseVariableDefinition(level + 1);
+    if (variableDefinition == nullptr) {
+        return nullptr;
+    }
+
+    if (!currentTokenIs(Token::SINGLE_EQUALS)) {
+        return AST_NODE(variableDefinition);
+    }
+
+    LOG_DEBUG(log, indent(level) + "parsing assignment statement");
+    auto afterDefinitionIdx = currentTokenIdx;
+    currentTokenIdx++;
+
+    auto *right = parseExpression(level + 1);
+    if (right == nullptr) {
+        // the definition on its own is still a valid statement, the caller has to deal with the equals sign
+        currentTokenIdx = afterDefinitionIdx;
+        return AST_NODE(variableDefinition);
+    }
+
+    LOG_DEBUG(log, indent(level) + "parsed assignment right");
+    return AST_NODE(tree.createAssignment(AST_NODE(variableDefinition), right));
+}
+
 AssertNode *Parser::parseAssert(int level) {
     if (!currentTokenIs(Token::ASSERT)) {
         return nullptr;
     }
 
-    log.debug(indent(level) + "parsing assert statement");
+    LOG_DEBUG(log, indent(level) + "parsing assert statement");
 
     currentTokenIdx++;
 
@@ -230,7 +257,7 @@ CommentNode *Parser::parseComment(int /*level*/) {
         return nullptr;
     }
 
-    log.debug("parsed comment node");
+    LOG_DEBUG(log, "parsed comment node");
 
     auto *result = tree.createComment(currentTokenContent());
     currentTokenIdx++;
@@ -238,115 +265,232 @@ CommentNode *Parser::parseComment(int /*level*/) {
 }
 
 StatementNode *Parser::parseStatement(int level) {
-    log.debug(indent(level) + "parsing statement node");
+    LOG_DEBUG(log, indent(level) + "parsing statement node");
 
     while (currentTokenIs(Token::NEW_LINE)) {
         currentTokenIdx++;
     }
 
-    auto *commentNode = parseComment(level + 1);
-    if (commentNode != nullptr) {
-        return tree.createStatement(AST_NODE(commentNode), false);
+    if (!tokens->has(currentTokenIdx)) {
+        return nullptr;
     }
 
-    auto *importNode = parseImport();
-    if (importNode != nullptr) {
-        return tree.createStatement(AST_NODE(importNode), false);
+    // NOTE the first token (and the second one for identifiers) determines the only production that can match, so
+    // there is no need to try the others once it failed
+    AstNode *result = nullptr;
+    switch (tokens->at(currentTokenIdx).type) {
+    case Token::COMMENT:
+        result = AST_NODE(parseComment(level + 1));
+        break;
+    case Token::IMPORT:
+        result = AST_NODE(parseImport());
+        break;
+    case Token::TYPE:
+        result = AST_NODE(parseTypeDeclaration(level + 1));
+        break;
+    case Token::ASSERT:
+        result = AST_NODE(parseAssert(level + 1));
+        break;
+    case Token::EXTERN:
+    case Token::FUN:
+        result = AST_NODE(parseFunction(level + 1));
+        break;
+    case Token::IF:
+        result = AST_NODE(parseIf(level + 1));
+        break;
+    case Token::FOR:
+        result = AST_NODE(parseFor(level + 1));
+        break;
+    case Token::RETURN:
+        return parseReturnStatement(level + 1);
+    case Token::SIMPLE_DATA_TYPE:
+        result = parseVariableDefinitionStatement(level + 1);
+        break;
+    case Token::IDENTIFIER:
+        if (nextTokenIs(Token::LEFT_PARAN)) {
+            result = AST_NODE(parseFunctionCall(level + 1));
+        } else if (nextTokenIs(Token::IDENTIFIER)) {
+            result = parseVariableDefinitionStatement(level + 1);
+        } else {
+            result = AST_NODE(parseAssignment(level + 1));
+        }
+        break;
+    default:
+        break;
     }
 
-    auto *typeNode = parseTypeDeclaration(level + 1);
-    if (typeNode != nullptr) {
-        return tree.createStatement(AST_NODE(typeNode), false);
+    if (result == nullptr) {
+        return nullptr;
     }
+    return tree.createStatement(result, false);
+}
 
-    auto *assertNode = parseAssert(level + 1);
-    if (assertNode != nullptr) {
-        return tree.createStatement(AST_NODE(assertNode), false);
-    }
+bool Parser::parseTopLevelStatements(std::vector<AstNode *> &children) {
+    while (tokens->has(currentTokenIdx)) {
+        const auto &token = tokens->at(currentTokenIdx);
+        if (token.type == Token::INVALID) {
+            // the token stream ends with the first invalid token
+            break;
+        }
 
-    auto *callNode = parseFunctionCall(level + 1);
-    if (callNode != nullptr) {
-        return tree.createStatement(AST_NODE(callNode), false);
-    }
+        if (token.type == Token::NEW_LINE) {
+            currentTokenIdx++;
+            tokens->release(currentTokenIdx);
+            continue;
+        }
 
-    auto *functionNode = parseFunction(level + 1);
-    if (functionNode != nullptr) {
-        return tree.createStatement(AST_NODE(functionNode), false);
-    }
+        const auto statementIdx = currentTokenIdx;
+        auto *statementNode = parseStatement(0);
+        if (statementNode == nullptr) {
+            currentTokenIdx = statementIdx;
+            return false;
+        }
 
-    auto *ifNode = parseIf(level + 1);
-    if (ifNode != nullptr) {
-        return tree.createStatement(AST_NODE(ifNode), false);
+        children.push_back(AST_NODE(statementNode));
+        // top level statements are never backtracked into, so their tokens can be dropped
+        tokens->release(currentTokenIdx);
     }
+    return true;
+}
 
-    auto *forNode = parseFor(level + 1);
-    if (forNode != nullptr) {
-        return tree.createStatement(AST_NODE(forNode), false);
+namespace {
+
+// Splits the tokens into batches of whole top level regions. A region ends with a new line that is not enclosed in
+// braces. No statement continues after such a new line, so every batch can be parsed on its own.
+std::vector<std::pair<size_t, size_t>> findBatches(const std::vector<Token> &allTokens, size_t minimumBatchSize) {
+    std::vector<std::pair<size_t, size_t>> batches = {};
+    size_t batchBegin = 0;
+    int64_t depth = 0;
+    for (size_t i = 0; i < allTokens.size(); i++) {
+        switch (allTokens[i].type) {
+        case Token::LEFT_CURLY_BRACE:
+            depth++;
+            break;
+        case Token::RIGHT_CURLY_BRACE:
+            depth--;
+            break;
+        case Token::NEW_LINE:
+            if (depth == 0 && i + 1 - batchBegin >= minimumBatchSize) {
+                batches.emplace_back(batchBegin, i + 1);
+                batchBegin = i + 1;
+            }
+            break;
+        default:
+            break;
+        }
     }
-
-    auto *assignmentNode = parseAssignment(level + 1);
-    if (assignmentNode != nullptr) {
-        return tree.createStatement(AST_NODE(assignmentNode), false);
+    if (batchBegin < allTokens.size()) {
+        batches.emplace_back(batchBegin, allTokens.size());
     }
+    return batches;
+}
 
-    auto *variableDefinition = parseVariableDefinition(level + 1);
-    if (variableDefinition != nullptr) {
-        return tree.createStatement(AST_NODE(variableDefinition), false);
+} // namespace
+
+bool Parser::parseTopLevelStatementsInParallel(std::vector<AstNode *> &children) {
+    // the regions can only be found once the whole module has been lexed
+    std::vector<Token> allTokens = {};
+    for (size_t i = 0; tokens->has(i); i++) {
+        allTokens.push_back(tokens->at(i));
+        tokens->release(i + 1);
+    }
+
+    const auto batchSize = std::max(options.minimumBatchSize, allTokens.size() / (options.parseThreads * 4));
+    const auto batches = findBatches(allTokens, batchSize);
+    if (batches.size() < 2) {
+        tokens = std::make_unique<TokenWindow>(std::move(allTokens));
+        return parseTopLevelStatements(children);
+    }
+
+    struct BatchResult {
+        std::vector<AstNode *> children = {};
+        size_t workerIdx = 0;
+        // the nodes of the batch in the tree of the worker
+        AstNodeID firstNode = 0;
+        AstNodeID endNode = 0;
+        bool success = false;
+    };
+    std::vector<BatchResult> results(batches.size());
+    std::atomic<size_t> nextBatch = 0;
+    std::atomic<bool> failed = false;
+
+    const auto threadCount = std::min(static_cast<size_t>(options.parseThreads), batches.size());
+    std::vector<AST> workerTrees(threadCount);
+    auto parseBatches = [&](size_t workerIdx) {
+        // every thread creates its nodes in the tree of its own parser, which is appended to the tree of this parser
+        Parser parser(log, lexer);
+        while (!failed.load(std::memory_order_relaxed)) {
+            const auto batchIdx = nextBatch.fetch_add(1, std::memory_order_relaxed);
+            if (batchIdx >= batches.size()) {
+                break;
+            }
+
+            const auto [begin, end] = batches[batchIdx];
+            parser.tokens = std::make_unique<TokenWindow>(
+                  std::vector<Token>(allTokens.begin() + static_cast<int64_t>(begin),
+                                     allTokens.begin() + static_cast<int64_t>(end)));
+            parser.currentTokenIdx = 0;
+            results[batchIdx].workerIdx = workerIdx;
+            results[batchIdx].firstNode = static_cast<AstNodeID>(parser.tree.size());
+            results[batchIdx].success = parser.parseTopLevelStatements(results[batchIdx].children);
+            results[batchIdx].endNode = static_cast<AstNodeID>(parser.tree.size());
+            if (!results[batchIdx].success) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        workerTrees[workerIdx] = parser.tree;
+    };
+
+    std::vector<std::thread> threads = {};
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(parseBatches, i);
+    }
+    parseBatches(0);
+    for (auto &thread : threads) {
+        thread.join();
     }
 
-    auto *returnStatement = parseReturnStatement(level + 1);
-    if (returnStatement != nullptr) {
-        return returnStatement;
+    if (failed) {
+        // parsing the whole module again reports the same error as the sequential parser would
+        tokens = std::make_unique<TokenWindow>(std::move(allTokens));
+        return parseTopLevelStatements(children);
     }
 
-    return nullptr;
+    // the nodes of a batch only link to each other, so appending the batches in source order gives every node the ID that
+    // the sequential parser would have given it. The roots of the worker trees are never copied.
+    for (auto &result : results) {
+        const auto offset = tree.append(workerTrees[result.workerIdx], result.firstNode, result.endNode);
+        for (auto *child : result.children) {
+            children.push_back(tree.get(child->id + offset));
+        }
+    }
+    return true;
 }
 
 void Parser::run(Module *module) {
-    while (true) {
-        const Token token = getNextToken();
-        if (token.type == Token::INVALID) {
-            break;
-        }
+    tokens = std::make_unique<TokenWindow>(lexer, options.lexInBackground);
+    if (options.keepTokens) {
+        tokens->history = &module->tokens;
     }
 
     std::vector<AstNode *> children = {};
-    bool error = false;
-
-    while (currentTokenIdx < tokens.size()) {
-        auto token = tokens[currentTokenIdx];
-        if (token.type == Token::INVALID) {
-            error = currentTokenIdx != tokens.size() - 1;
-            break;
-        }
-
-        if (token.type == Token::NEW_LINE) {
-            currentTokenIdx++;
-            continue;
-        }
-
-        auto *statementNode = parseStatement(0);
-        if (statementNode != nullptr) {
-            children.push_back(AST_NODE(statementNode));
-            continue;
-        }
-
-        log.error("Unexpected token: " + to_string(token.type) + ": " + token.content);
-        error = true;
-        break;
+    bool success = false;
+    if (options.parseThreads > 1) {
+        success = parseTopLevelStatementsInParallel(children);
+    } else {
+        success = parseTopLevelStatements(children);
     }
 
-    if (error) {
+    if (!success) {
+        const auto &token = tokens->at(currentTokenIdx);
+        log.error("Unexpected token: " + to_string(token.type) + ": " + std::string(token.content));
+        tokens.reset();
         return;
     }
+    tokens.reset();
 
-    auto *root = tree.root();
-    root->type = ast::NodeType::SEQUENCE;
-    for (auto *child : children) {
-        root->sequence.children.push_back(child);
-    }
+    tree.root()->sequence.children = tree.createList(children);
     tree.completed();
 
     module->ast = tree;
-    module->tokens = tokens;
 }
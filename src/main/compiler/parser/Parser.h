@@ -3,24 +3,45 @@
 #include "../../Module.h"
 #include "../Logger.h"
 #include "../ast/AstNode.h"
+#include "TokenWindow.h"
+
+#include <memory>
+
+struct ParserOptions {
+    // stores all tokens in Module::tokens, which is only needed to print the module again
+    bool keepTokens = false;
+    // lexes on a separate thread, while the parser is consuming the tokens
+    bool lexInBackground = false;
+    // parses the top level regions of the module on this many threads, the resulting tree is the same as with a single
+    // thread
+    unsigned parseThreads = 1;
+    // the smallest number of tokens that is worth handing to another thread
+    size_t minimumBatchSize = 4096;
+};
 
 class Parser {
     const Logger &log;
     Lexer &lexer;
+    ParserOptions options;
 
     AST tree;
-    std::vector<Token> tokens;
+    std::unique_ptr<TokenWindow> tokens;
     int currentTokenIdx = 0;
 
   public:
-    Parser(const Logger &logger, Lexer &lexer) : log(logger), lexer(lexer) {}
+    Parser(const Logger &logger, Lexer &lexer, ParserOptions options = {})
+        : log(logger), lexer(lexer), options(options) {}
 
     void run(Module *module);
 
   private:
-    Token getNextToken();
     [[nodiscard]] bool currentTokenIs(Token::TokenType tokenType) const;
-    [[nodiscard]] std::string currentTokenContent() const;
+    [[nodiscard]] bool nextTokenIs(Token::TokenType tokenType) const;
+    [[nodiscard]] std::string_view currentTokenContent() const;
+    [[nodiscard]] Symbol currentTokenSymbol() const;
+
+    bool parseTopLevelStatements(std::vector<AstNode *> &children);
+    bool parseTopLevelStatementsInParallel(std::vector<AstNode *> &children);
 
     StatementNode *parseStatement(int level);
     AssertNode *parseAssert(int level);
@@ -32,20 +53,19 @@ class Parser {
     FunctionNode *parseFunction(int level);
     SequenceNode *parseScope(int level);
     VariableDefinitionNode *parseVariableDefinition(int level);
+    AstNode *parseVariableDefinitionStatement(int level);
     CallNode *parseFunctionCall(int level);
     VariableNode *parseVariable(int level);
+    AstNode *parseVariableOrMemberAccess(int level);
     AstNode *parseAssignmentLeft(int level);
     LiteralNode *parseLiteral(int level);
     CommentNode *parseComment(int level);
     TypeDeclarationNode *parseTypeDeclaration(int level);
     TypeMemberNode *parseMemberVariable(int level);
-    MemberAccessNode *parseMemberAccess(int level);
+    MemberAccessNode *parseMemberAccess(AstNode *left, int level);
 
     AstNode *parseExpression(int level);
-    AstNode *parseEquality(int level);
-    AstNode *parseComparison(int level);
-    AstNode *parseTerm(int level);
-    AstNode *parseFactor(int level);
+    AstNode *parseBinaryOperation(int level, int minimumPrecedence);
     AstNode *parseUnary(int level);
     AstNode *parsePrimary(int level);
 
@@ -0,0 +1,98 @@
+#include "TokenWindow.h"
+
+#include <bit>
+
+TokenWindow::TokenWindow(Lexer &lexer, bool lexInBackground) : lexer(&lexer), buffer(64) {
+    if (lexInBackground) {
+        lexerThread = std::thread(&TokenWindow::runLexer, this);
+    }
+}
+
+TokenWindow::TokenWindow(std::vector<Token> tokens) : endReached(true), buffer(std::move(tokens)) {
+    end = buffer.size();
+    // the tokens stay where they are, growing the buffer to a power of two only appends empty slots
+    buffer.resize(std::bit_ceil(std::max(end, size_t(1))));
+}
+
+TokenWindow::~TokenWindow() {
+    if (!lexerThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopLexing = true;
+    }
+    chunkConsumed.notify_one();
+    lexerThread.join();
+}
+
+bool TokenWindow::has(size_t index) {
+    while (index >= end && !endReached) {
+        push(nextToken());
+    }
+    return index < end;
+}
+
+void TokenWindow::release(size_t index) {
+    if (index > begin) {
+        begin = std::min(index, end);
+    }
+}
+
+void TokenWindow::push(const Token &token) {
+    if (end - begin == buffer.size()) {
+        // the window is full, double its size and move the tokens to their new positions
+        std::vector<Token> newBuffer(buffer.size() * 2);
+        for (size_t i = begin; i < end; i++) {
+            newBuffer[i & (newBuffer.size() - 1)] = at(i);
+        }
+        buffer = std::move(newBuffer);
+    }
+
+    buffer[end & (buffer.size() - 1)] = token;
+    end++;
+    if (token.type == Token::INVALID) {
+        endReached = true;
+    }
+    if (history != nullptr) {
+        history->push_back(token);
+    }
+}
+
+Token TokenWindow::nextToken() {
+    if (!lexerThread.joinable()) {
+        return lexer->getToken();
+    }
+
+    if (currentChunkIdx == currentChunk.size()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        chunkAvailable.wait(lock, [this]() { return !chunks.empty(); });
+        currentChunk = std::move(chunks.front());
+        chunks.pop_front();
+        currentChunkIdx = 0;
+        lock.unlock();
+        chunkConsumed.notify_one();
+    }
+    return currentChunk[currentChunkIdx++];
+}
+
+void TokenWindow::runLexer() {
+    bool done = false;
+    while (!done) {
+        std::vector<Token> chunk = {};
+        chunk.reserve(CHUNK_SIZE);
+        while (chunk.size() < CHUNK_SIZE && !done) {
+            chunk.push_back(lexer->getToken());
+            done = chunk.back().type == Token::INVALID;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        chunkConsumed.wait(lock, [this]() { return chunks.size() < MAX_QUEUED_CHUNKS || stopLexing; });
+        if (stopLexing) {
+            return;
+        }
+        chunks.push_back(std::move(chunk));
+        lock.unlock();
+        chunkAvailable.notify_one();
+    }
+}
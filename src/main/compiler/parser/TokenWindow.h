@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../lexer/Lexer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Streams tokens from the lexer to the parser. Only the tokens after the last position that was released are kept,
+// they are stored in a ring buffer that grows when the parser looks further ahead than it ever did before. The stream
+// ends after the first INVALID token.
+class TokenWindow {
+  public:
+    // NOTE with lexInBackground set, the lexer runs on its own thread and must not be used by anybody else until the
+    // window has been destroyed
+    TokenWindow(Lexer &lexer, bool lexInBackground);
+    // a window over tokens that have been lexed before, the stream ends after the last one of them
+    explicit TokenWindow(std::vector<Token> tokens);
+    ~TokenWindow();
+    TokenWindow(const TokenWindow &) = delete;
+    TokenWindow &operator=(const TokenWindow &) = delete;
+
+    // returns whether the stream contains a token at index, lexing up to it if necessary
+    bool has(size_t index);
+    // NOTE index has to be in the window, meaning has(index) returned true and index was not released yet
+    [[nodiscard]] const Token &at(size_t index) const { return buffer[index & (buffer.size() - 1)]; }
+    // drops all tokens before index, the parser promises to never go back further than that
+    void release(size_t index);
+
+    // every token that has been read, is also appended to this vector, if it is set
+    std::vector<Token> *history = nullptr;
+
+  private:
+    Lexer *lexer = nullptr;
+    bool endReached = false;
+
+    std::vector<Token> buffer;
+    // absolute index of the first token in the window and one past the last one
+    size_t begin = 0;
+    size_t end = 0;
+
+    // tokens are handed over from the lexer thread in chunks to keep the synchronization overhead low
+    static const size_t CHUNK_SIZE = 1024;
+    static const size_t MAX_QUEUED_CHUNKS = 16;
+    std::thread lexerThread;
+    std::mutex mutex;
+    std::condition_variable chunkAvailable;
+    std::condition_variable chunkConsumed;
+    std::deque<std::vector<Token>> chunks;
+    bool stopLexing = false;
+    std::vector<Token> currentChunk;
+    size_t currentChunkIdx = 0;
+
+    void push(const Token &token);
+    Token nextToken();
+    void runLexer();
+};
@@ -1,38 +1,37 @@
 #include "Parser.h"
 
 LiteralNode *Parser::parseLiteral(int level) {
-    log.debug(indent(level) + "parsing literal node");
+    LOG_DEBUG(log, indent(level) + "parsing literal node");
 
     if (currentTokenIs(Token::INTEGER)) {
-        log.debug(indent(level) + "parsing integer node");
-        int64_t value = std::stoi(currentTokenContent());
+        LOG_DEBUG(log, indent(level) + "parsing integer node");
+        int64_t value = std::stoi(std::string(currentTokenContent()));
         currentTokenIdx++;
         return tree.createLiteralInteger(value);
     }
 
     if (currentTokenIs(Token::FLOAT)) {
-        log.debug(indent(level) + "parsed float node");
-        double value = std::stof(currentTokenContent());
+        LOG_DEBUG(log, indent(level) + "parsed float node");
+        double value = std::stof(std::string(currentTokenContent()));
         currentTokenIdx++;
         return tree.createLiteralFloat(value);
     }
 
     if (currentTokenIs(Token::BOOLEAN)) {
-        log.debug(indent(level) + "parsed boolean node");
+        LOG_DEBUG(log, indent(level) + "parsed boolean node");
         bool value = currentTokenContent() == "true";
         currentTokenIdx++;
         return tree.createLiteralBool(value);
     }
 
     if (currentTokenIs(Token::STRING)) {
-        log.debug(indent(level) + "parsed string node");
-        std::string value = currentTokenContent();
-        value = value.substr(1, value.size() - 2);
+        LOG_DEBUG(log, indent(level) + "parsed string node");
+        auto value = currentTokenContent().substr(1, currentTokenContent().size() - 2);
         currentTokenIdx++;
         return tree.createLiteralString(value);
     }
 
-    log.debug(indent(level) + "failed to parse literal node");
+    LOG_DEBUG(log, indent(level) + "failed to parse literal node");
     return nullptr;
 }
 
@@ -60,7 +59,7 @@ TypeDeclarationNode *Parser::parseTypeDeclaration(int level) {
         return nullptr;
     }
 
-    std::string name = currentTokenContent();
+    auto name = currentTokenSymbol();
     currentTokenIdx++;
 
     if (!currentTokenIs(Token::LEFT_CURLY_BRACE)) {
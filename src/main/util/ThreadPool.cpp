@@ -0,0 +1,105 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+
+// identifies the pool and the queue of the worker that is running on the current thread
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local size_t currentWorkerIdx = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    threadCount = std::max(1u, threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::runWorker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    const auto queueIdx =
+          currentPool == this ? currentWorkerIdx : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        // NOTE the counters are changed under the lock, so that a worker can't miss the wake up. They are changed
+        // before the task is queued, so that a worker can't take and finish it before it is counted.
+        std::lock_guard lock(mutex);
+        pendingTasks++;
+        queuedTasks++;
+    }
+    {
+        auto &queue = *queues[queueIdx];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(mutex);
+    allDone.wait(lock, [this]() { return pendingTasks == 0; });
+}
+
+bool ThreadPool::takeTask(size_t workerIdx, std::function<void()> &task) {
+    {
+        auto &queue = *queues[workerIdx];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < queues.size(); i++) {
+        auto &queue = *queues[(workerIdx + i) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runWorker(size_t workerIdx) {
+    currentPool = this;
+    currentWorkerIdx = workerIdx;
+
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(workerIdx, task)) {
+            queuedTasks--;
+            task();
+
+            std::lock_guard lock(mutex);
+            pendingTasks--;
+            if (pendingTasks == 0) {
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(mutex);
+        workAvailable.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs tasks on a fixed number of threads. Every worker has its own queue: tasks that are submitted by a worker go to
+// the back of its own queue and are also taken from there, idle workers steal from the front of the other queues. This
+// keeps tasks that discover more work (like loading a module that imports other modules) close to their parent.
+class ThreadPool {
+  public:
+    explicit ThreadPool(unsigned int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+    // blocks until all tasks have finished, including the ones that were submitted by running tasks
+    void wait();
+
+  private:
+    struct WorkerQueue {
+        std::mutex mutex = {};
+        std::deque<std::function<void()>> tasks = {};
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues = {};
+    std::vector<std::thread> threads = {};
+    std::atomic<size_t> nextQueue = 0;
+
+    std::mutex mutex = {};
+    std::condition_variable workAvailable = {};
+    std::condition_variable allDone = {};
+    // queued tasks have not been taken by a worker yet, pending tasks have not finished yet
+    std::atomic<size_t> queuedTasks = 0;
+    size_t pendingTasks = 0;
+    bool stopping = false;
+
+    void runWorker(size_t workerIdx);
+    bool takeTask(size_t workerIdx, std::function<void()> &task);
+};
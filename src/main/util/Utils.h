@@ -6,7 +6,7 @@
     std::cout << __FILE__ << ":" << __FUNCTION__ << ": Not implemented yet." << std::endl;                             \
     exit(1);
 
-#define STARTS_WITH(word, search) word.find(search) == 0
+#define STARTS_WITH(word, search) word.starts_with(search)
 #define TOKEN(type, content) std::optional<Token>({type, content})
 
 std::string replace(const std::string &str, const std::string &from, const std::string &to);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Creates a program with the given number of functions, which covers comments, literals of every type, control flow,
+// operators and calls. The prefix is added to the names of the functions, to keep them unique across modules.
+inline std::vector<std::string> generateProgram(int numFunctions, const std::string &namePrefix = "") {
+    std::vector<std::string> lines = {};
+    for (int i = 0; i < numFunctions; i++) {
+        const std::string n = namePrefix + std::to_string(i);
+        lines.push_back("# computes something very important, number " + n);
+        lines.push_back("fun compute" + n + "(int a, float b) int {");
+        lines.push_back("    int x = a * 2 + 15");
+        lines.push_back("    float y = b / 3.25");
+        lines.push_back("    string s = \"some string value\"");
+        lines.push_back("    if x >= 10 and not false {");
+        lines.push_back("        x = x - 1");
+        lines.push_back("    }");
+        lines.push_back("    for int j = 0; j < 10; j = j + 1 {");
+        lines.push_back("        x = compute" + n + "(x, b) + j");
+        lines.push_back("    }");
+        lines.push_back("    return x");
+        lines.push_back("}");
+        lines.push_back("");
+    }
+    return lines;
+}
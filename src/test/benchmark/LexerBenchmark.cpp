@@ -0,0 +1,69 @@
+#include <compiler/Logger.h>
+#include <compiler/lexer/Lexer.h>
+#include <compiler/lexer/Scanner.h>
+#include <util/Timing.h>
+
+#include "BenchmarkPrograms.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int lexAllTokens(CodeProvider *codeProvider, const Logger &logger) {
+    SymbolTable symbolTable = {};
+    Lexer lexer(codeProvider, symbolTable, logger);
+    int numTokens = 0;
+    while (lexer.getToken().type != Token::INVALID) {
+        numTokens++;
+    }
+    return numTokens;
+}
+
+void runBenchmark(const std::vector<std::string> &lines, const char *fileName, const Logger &logger) {
+    const int iterations = 10;
+
+    TimeKeeper timeKeeper = {};
+    std::chrono::nanoseconds totalTime = {};
+    int64_t totalTokens = 0;
+    for (int i = 0; i < iterations; i++) {
+        int numTokens = 0;
+        {
+            auto timer = Timer(timeKeeper, "lex");
+            if (fileName != nullptr) {
+                auto codeProvider = FileCodeProvider(fileName);
+                numTokens = lexAllTokens(&codeProvider, logger);
+            } else {
+                auto codeProvider = StringCodeProvider(lines, true);
+                numTokens = lexAllTokens(&codeProvider, logger);
+            }
+        }
+        totalTime += timeKeeper.get("lex");
+        totalTokens += numTokens;
+    }
+
+    const double seconds = static_cast<double>(totalTime.count()) / 1.0e+9;
+    std::cout << to_string(getScannerImplementation()) << ": lexed " << totalTokens << " tokens in " << seconds
+              << "s (" << iterations << " iterations)" << std::endl;
+    std::cout << to_string(getScannerImplementation()) << ": "
+              << static_cast<int64_t>(static_cast<double>(totalTokens) / seconds) << " tokens/sec" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    const int numFunctions = 5000;
+
+    Logger logger = {};
+    logger.setLogLevel(Logger::LogLevel::INFO);
+
+    auto lines = generateProgram(numFunctions);
+    const char *fileName = argc > 1 ? argv[1] : nullptr;
+
+    for (auto implementation :
+         {ScannerImplementation::SCALAR, ScannerImplementation::SSE2, ScannerImplementation::AVX2}) {
+        if (!isSupported(implementation)) {
+            continue;
+        }
+        setScannerImplementation(implementation);
+        runBenchmark(lines, fileName, logger);
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <BuildEnv.h>
+#include <Module.h>
+#include <compiler/Logger.h>
+#include <compiler/ModuleCache.h>
+#include <compiler/lexer/Lexer.h>
+#include <compiler/parser/Parser.h>
+#include <util/Timing.h>
+
+#include "BenchmarkPrograms.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// creates a project with the given number of modules, the first one imports all the others
+std::vector<std::string> generateProject(const std::filesystem::path &directory, int numModules, int numFunctions) {
+    std::vector<std::string> moduleFileNames = {};
+    std::ofstream mainModule(directory / "main.ne");
+    moduleFileNames.push_back("main.ne");
+    for (int m = 1; m < numModules; m++) {
+        const std::string fileName = "module" + std::to_string(m) + ".ne";
+        mainModule << "import \"" << fileName << "\"\n";
+        moduleFileNames.push_back(fileName);
+
+        std::ofstream module(directory / fileName);
+        for (const auto &line : generateProgram(numFunctions, std::to_string(m) + "_")) {
+            module << line << "\n";
+        }
+    }
+    return moduleFileNames;
+}
+
+// loads all modules the same way the compiler does
+std::chrono::nanoseconds loadModules(const std::filesystem::path &directory,
+                                     const std::vector<std::string> &moduleFileNames, const BuildEnv &buildEnv,
+                                     const Logger &logger) {
+    TimeKeeper timeKeeper = {};
+    SymbolTable symbolTable = {};
+    std::vector<std::unique_ptr<Module>> modules = {};
+    {
+        auto timer = Timer(timeKeeper, "build");
+        ModuleCache moduleCache(&buildEnv, symbolTable, logger);
+        for (const auto &moduleFileName : moduleFileNames) {
+            modules.push_back(std::make_unique<Module>(directory / moduleFileName));
+            auto *module = modules.back().get();
+            const auto sourceHash = ModuleCache::hashSource(module->getFilePath());
+            if (moduleCache.load(module, *sourceHash)) {
+                continue;
+            }
+
+            Lexer lexer(module->getCodeProvider(), symbolTable, logger);
+            Parser parser(logger, lexer);
+            parser.run(module);
+            if (!module->ast.is_complete()) {
+                std::cerr << "failed to parse the benchmark program" << std::endl;
+                exit(1);
+            }
+            moduleCache.store(module, *sourceHash);
+        }
+    }
+    return timeKeeper.get("build");
+}
+
+int main() {
+    Logger logger = {};
+    logger.setLogLevel(Logger::LogLevel::INFO);
+
+    const auto directory = std::filesystem::temp_directory_path() / "neon-module-cache-benchmark";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto moduleFileNames = generateProject(directory, 100, 200);
+
+    const int iterations = 5;
+    std::chrono::nanoseconds coldTime = {};
+    std::chrono::nanoseconds warmTime = {};
+    for (int i = 0; i < iterations; i++) {
+        const auto buildDirectory = directory / "neon-build";
+        std::filesystem::remove_all(buildDirectory);
+        const BuildEnv buildEnv(buildDirectory.string());
+        // NOTE the module paths are absolute, the cache entries are placed below the same path in the build directory
+        std::filesystem::create_directories(buildDirectory.string() + "/" + directory.string());
+
+        coldTime += loadModules(directory, moduleFileNames, buildEnv, logger);
+        warmTime += loadModules(directory, moduleFileNames, buildEnv, logger);
+    }
+    std::filesystem::remove_all(directory);
+
+    std::cout << "cold build of " << moduleFileNames.size() << " modules: " << coldTime.count() / iterations / 1000
+              << "us" << std::endl;
+    std::cout << "warm build of " << moduleFileNames.size() << " modules: " << warmTime.count() / iterations / 1000
+              << "us" << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <Module.h>
+#include <compiler/Logger.h>
+#include <compiler/lexer/Lexer.h>
+#include <compiler/parser/Parser.h>
+#include <util/Timing.h>
+
+#include "BenchmarkPrograms.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::vector<std::string> generateExpressionProgram(int numLines) {
+    std::vector<std::string> lines = {};
+    for (int i = 0; i < numLines; i++) {
+        const std::string n = std::to_string(i);
+        lines.push_back("bool b" + n + " = a * " + n + " + b / 2 - c >= -d * (e + 1) and not f == g or h < i * j - k");
+    }
+    return lines;
+}
+
+// creates "int x = a[a[a[0]]]" and "print(f(f(f(1))))" with the given depth
+std::vector<std::string> generateNestedProgram(int depth) {
+    std::string arrayAccess = "0";
+    std::string call = "1";
+    for (int i = 0; i < depth; i++) {
+        arrayAccess = "a[" + arrayAccess + "]";
+        call = "f(" + call + ")";
+    }
+    return {"int x = " + arrayAccess, "print(" + call + ")"};
+}
+
+std::chrono::nanoseconds parse(const std::vector<std::string> &lines, const Logger &logger) {
+    TimeKeeper timeKeeper = {};
+    auto codeProvider = StringCodeProvider(lines, true);
+    auto module = Module("benchmark.ne");
+    SymbolTable symbolTable = {};
+    Lexer lexer(&codeProvider, symbolTable, logger);
+    {
+        auto timer = Timer(timeKeeper, "parse");
+        Parser parser(logger, lexer);
+        parser.run(&module);
+    }
+    if (!module.ast.is_complete()) {
+        std::cerr << "failed to parse the benchmark program" << std::endl;
+        exit(1);
+    }
+    return timeKeeper.get("parse");
+}
+
+void printThroughput(const std::string &name, const std::vector<std::string> &lines, const Logger &logger) {
+    const int iterations = 5;
+    std::chrono::nanoseconds totalTime = {};
+    for (int i = 0; i < iterations; i++) {
+        totalTime += parse(lines, logger);
+    }
+    const double seconds = static_cast<double>(totalTime.count()) / 1.0e+9;
+    std::cout << name << ": parsed " << lines.size() * iterations << " lines in " << seconds << "s (" << iterations
+              << " iterations)" << std::endl;
+    std::cout << name << ": " << static_cast<int64_t>(static_cast<double>(lines.size() * iterations) / seconds)
+              << " lines/sec" << std::endl;
+}
+
+int main() {
+    Logger logger = {};
+    logger.setLogLevel(Logger::LogLevel::INFO);
+
+    printThroughput("functions", generateProgram(5000), logger);
+    printThroughput("expressions", generateExpressionProgram(20000), logger);
+
+    // the time per nesting level should stay the same, no matter how deep the expressions are nested
+    for (int depth = 16; depth <= 1024; depth *= 2) {
+        const auto time = parse(generateNestedProgram(depth), logger);
+        std::cout << "nesting depth " << depth << ": " << time.count() / 1000 << "us ("
+                  << time.count() / depth << "ns per level)" << std::endl;
+    }
+    return 0;
+}
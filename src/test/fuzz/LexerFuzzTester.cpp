@@ -4,7 +4,8 @@
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     Logger logger = {};
     auto codeProvider = ByteCodeProvider((char *)data, size);
-    Lexer lexer(&codeProvider, logger);
+    SymbolTable symbolTable = {};
+    Lexer lexer(&codeProvider, symbolTable, logger);
 
     do {
         auto token = lexer.getToken();
@@ -7,9 +7,9 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     Logger logger = {};
     logger.setLogLevel(Logger::DISABLED);
     auto codeProvider = ByteCodeProvider((char *)data, size);
-    Lexer lexer(&codeProvider, logger);
-    auto context = new llvm::LLVMContext();
-    auto module = new Module("", *context);
+    SymbolTable symbolTable = {};
+    Lexer lexer(&codeProvider, symbolTable, logger);
+    auto module = new Module("");
     Parser parser(logger, lexer);
     parser.run(module);
     return 0;
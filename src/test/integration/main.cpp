@@ -1,5 +1,8 @@
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <regex>
 #include <string>
 
 #include <BuildEnv.h>
@@ -100,6 +103,28 @@ TestResult compileAndRun(const std::string &path, const Logger &logger) {
 #endif
 }
 
+std::optional<std::string> compileToIr(const std::string &path, const Logger &logger) {
+    auto program = Program(path);
+    auto buildEnv = BuildEnv();
+    auto compiler = Compiler(&program, &buildEnv, logger);
+    if (compiler.run()) {
+        return {};
+    }
+
+    std::ifstream infile(buildEnv.buildDirectory + program.name + ".llvm", std::ios::binary);
+    if (!infile.good()) {
+        return {};
+    }
+    return std::string(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+}
+
+// the modules are loaded in parallel, but the order in which they are loaded must not show up in the output
+bool isReproducible(const std::string &path, const Logger &logger) {
+    const auto firstBuild = compileToIr(path, logger);
+    const auto secondBuild = compileToIr(path, logger);
+    return firstBuild && secondBuild && *firstBuild == *secondBuild;
+}
+
 std::vector<std::filesystem::path> collectTests(const CmdArguments &args) {
     std::vector<std::filesystem::path> results = {};
     if (!std::filesystem::exists(args.testDirectory)) {
@@ -227,6 +252,18 @@ int main(int argc, char **argv) {
         std::cout << " (compile: " << std::setw(7) << result.compileTimeMillis() << "ms, link: " << std::setw(7)
                   << result.linkTimeMillis() << "ms, run: " << std::setw(7) << result.runTimeMillis()
                   << "ms, exitCode: " << std::setw(2) << result.exitCode << "): " << path << std::endl;
+
+        if (path.filename() == "import_test.ne") {
+            totalNumTests++;
+            const bool reproducible = isReproducible(path.string(), logger);
+            if (reproducible) {
+                successfulTests++;
+            } else {
+                success = false;
+            }
+            std::cout << addResultColor(reproducible, false) << (reproducible ? "SUCCESS" : "FAILURE") << "\u001b[0m"
+                      << " (identical IR of two builds): " << path << std::endl;
+        }
     }
 
     int exitCode = 0;
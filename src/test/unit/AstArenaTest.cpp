@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ast/AST.h"
+
+#include <vector>
+
+TEST_CASE("AST Arena") {
+    SECTION("starts small") {
+        AST tree = {};
+        const auto statistics = tree.arenaStatistics();
+        REQUIRE(statistics.nodeCount == 1);
+        REQUIRE(statistics.chunkCount == 1);
+        REQUIRE(statistics.bytesReserved < 1024 * 1024);
+        REQUIRE(tree.root()->id == AST::ROOT_ID);
+    }
+
+    SECTION("grows without moving nodes") {
+        AST tree = {};
+        std::vector<LiteralNode *> literals = {};
+        for (int64_t i = 0; i < 100000; i++) {
+            literals.push_back(tree.createLiteralInteger(i));
+        }
+
+        for (int64_t i = 0; i < 100000; i++) {
+            REQUIRE(AST_NODE(literals[i])->type == ast::NodeType::LITERAL);
+            REQUIRE(literals[i]->i == i);
+            REQUIRE(tree.get(AST_NODE(literals[i])->id) == AST_NODE(literals[i]));
+        }
+
+        const auto statistics = tree.arenaStatistics();
+        REQUIRE(statistics.nodeCount == 100001);
+        REQUIRE(statistics.nodeCapacity >= statistics.nodeCount);
+        // the chunks grow geometrically, so only a few of them are needed
+        REQUIRE(statistics.chunkCount < 16);
+    }
+
+    SECTION("links nodes by ID") {
+        AST tree = {};
+        auto *left = tree.createLiteralInteger(1);
+        auto *right = tree.createLiteralInteger(2);
+        auto *operation = tree.createBinaryOperation(ast::BinaryOperationType::ADDITION, AST_NODE(left), AST_NODE(right));
+        auto *statement = tree.createStatement(AST_NODE(operation), false);
+
+        REQUIRE(statement->child == AST_NODE(operation)->id);
+        REQUIRE(tree.get(operation->left) == AST_NODE(left));
+        REQUIRE(tree.get(operation->right) == AST_NODE(right));
+        REQUIRE(tree.createStatement(nullptr, true)->child == NO_NODE);
+        REQUIRE(tree.get(NO_NODE) == nullptr);
+    }
+
+    SECTION("appends other trees") {
+        AST tree = {};
+        tree.createComment("# a node that shifts the IDs of the appended nodes");
+        AstNodeID sequenceID = NO_NODE;
+        {
+            AST other = {};
+            auto *literal = other.createLiteralString("some string that does not fit into the small string buffer");
+            auto *statement = other.createStatement(AST_NODE(literal), false);
+            auto *sequence = other.createSequence({AST_NODE(statement)});
+            sequenceID = AST_NODE(sequence)->id + tree.append(other);
+        }
+
+        REQUIRE(tree.arenaStatistics().nodeCount == 2 + 4);
+        auto *sequence = tree.get(sequenceID);
+        REQUIRE(sequence->type == ast::NodeType::SEQUENCE);
+        REQUIRE(sequence->id == sequenceID);
+        auto *statement = tree.nodes(sequence->sequence.children)[0];
+        REQUIRE(statement->type == ast::NodeType::STATEMENT);
+        auto *literal = tree.get(statement->statement.child);
+        REQUIRE(tree.string(literal->literal.s) == "some string that does not fit into the small string buffer");
+    }
+
+    SECTION("stores lists and strings in the arena") {
+        AST tree = {};
+        std::vector<AstNode *> children = {};
+        for (int i = 0; i < 1000; i++) {
+            children.push_back(AST_NODE(tree.createComment("# comment number " + std::to_string(i))));
+        }
+        auto *sequence = tree.createSequence(children);
+
+        const auto nodes = tree.nodes(sequence->children);
+        REQUIRE(nodes.size() == 1000);
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(nodes[i] == children[i]);
+            REQUIRE(tree.string(nodes[i]->comment.content) == "# comment number " + std::to_string(i));
+        }
+
+        const auto statistics = tree.arenaStatistics();
+        REQUIRE(statistics.dataBytes >= 1000 * sizeof(AstNodeID));
+        REQUIRE(statistics.bytesReserved >= statistics.dataBytes + statistics.nodeCount * sizeof(AstNode));
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ast/visitors/AstVisitor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// records the order in which the nodes are entered and left
+class RecordingVisitor : public AstVisitor<RecordingVisitor> {
+    friend class AstVisitor<RecordingVisitor>;
+
+  public:
+    explicit RecordingVisitor(const AST *tree) : AstVisitor(tree) {}
+
+    std::vector<ast::NodeType> entered = {};
+    std::vector<ast::NodeType> left = {};
+    std::vector<int64_t> literals = {};
+    bool skipUnaryOperations = false;
+    int64_t stopAtLiteral = -1;
+
+  private:
+    bool preVisit(AstNode *node) {
+        if (skipUnaryOperations && node->type == ast::NodeType::UNARY_OPERATION) {
+            return false;
+        }
+        entered.push_back(node->type);
+        return true;
+    }
+    void postVisit(AstNode *node) { left.push_back(node->type); }
+
+    void visitLiteralNode(LiteralNode *node) {
+        literals.push_back(node->i);
+        if (node->i == stopAtLiteral) {
+            stop();
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("AST Visitor") {
+    // 1 + -2; 3 * 4
+    AST tree = {};
+    auto *first = tree.createStatement(
+          AST_NODE(tree.createBinaryOperation(
+                ast::BinaryOperationType::ADDITION, AST_NODE(tree.createLiteralInteger(1)),
+                AST_NODE(tree.createUnaryOperation(ast::UnaryOperationType::NEGATE,
+                                                   AST_NODE(tree.createLiteralInteger(2)))))),
+          false);
+    auto *second = tree.createStatement(AST_NODE(tree.createBinaryOperation(ast::BinaryOperationType::MULTIPLICATION,
+                                                                            AST_NODE(tree.createLiteralInteger(3)),
+                                                                            AST_NODE(tree.createLiteralInteger(4)))),
+                                        false);
+    auto *sequence = AST_NODE(tree.createSequence({AST_NODE(first), AST_NODE(second)}));
+
+    SECTION("visits all children in source order") {
+        RecordingVisitor visitor(&tree);
+        visitor.visitNode(sequence);
+        REQUIRE(visitor.literals == std::vector<int64_t>{1, 2, 3, 4});
+        REQUIRE(visitor.entered.size() == 10);
+        REQUIRE(visitor.entered.front() == ast::NodeType::SEQUENCE);
+        REQUIRE(visitor.left.size() == 10);
+        REQUIRE(visitor.left.back() == ast::NodeType::SEQUENCE);
+        REQUIRE(visitor.left.front() == ast::NodeType::LITERAL);
+    }
+
+    SECTION("skips nodes that are rejected by preVisit") {
+        RecordingVisitor visitor(&tree);
+        visitor.skipUnaryOperations = true;
+        visitor.visitNode(sequence);
+        REQUIRE(visitor.literals == std::vector<int64_t>{1, 3, 4});
+        REQUIRE(visitor.entered.size() == 8);
+        REQUIRE(visitor.left.size() == 8);
+    }
+
+    SECTION("stops early") {
+        RecordingVisitor visitor(&tree);
+        visitor.stopAtLiteral = 2;
+        visitor.visitNode(sequence);
+        REQUIRE(visitor.literals == std::vector<int64_t>{1, 2});
+        REQUIRE(std::count(visitor.entered.begin(), visitor.entered.end(), ast::NodeType::STATEMENT) == 1);
+    }
+}
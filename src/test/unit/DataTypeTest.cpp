@@ -0,0 +1,53 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ast/Types.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("Data Types") {
+    SECTION("simple types have fixed IDs") {
+        REQUIRE(ast::DataType().id == ast::SimpleDataType::VOID);
+        REQUIRE(ast::DataType(ast::SimpleDataType::STRING).id == ast::SimpleDataType::STRING);
+        REQUIRE(ast::DataType("INT") == ast::DataType(ast::SimpleDataType::INTEGER));
+        REQUIRE(ast::DataType(ast::SimpleDataType::FLOAT).name() == "FLOAT");
+        REQUIRE(ast::toSimpleDataType(ast::DataType(ast::SimpleDataType::BOOLEAN)) == ast::SimpleDataType::BOOLEAN);
+    }
+
+    SECTION("knows which types are primitive") {
+        REQUIRE(ast::DataType(ast::SimpleDataType::INTEGER).isPrimitive());
+        REQUIRE(ast::DataType(ast::SimpleDataType::BOOLEAN).isPrimitive());
+        REQUIRE_FALSE(ast::DataType(ast::SimpleDataType::STRING).isPrimitive());
+        REQUIRE_FALSE(ast::DataType(ast::SimpleDataType::VOID).isPrimitive());
+        REQUIRE_FALSE(ast::DataType("Point").isPrimitive());
+        REQUIRE_FALSE(ast::DataType("Point").isSimple());
+    }
+
+    SECTION("interns complex types by name") {
+        const auto point = ast::DataType("Point");
+        REQUIRE(point == ast::DataType(std::string("Point")));
+        REQUIRE(point != ast::DataType("Line"));
+        REQUIRE(point.name() == "Point");
+        REQUIRE(std::hash<ast::DataType>()(point) == point.id);
+    }
+
+    SECTION("interns the same name once across threads") {
+        const int numThreads = 8;
+        std::vector<ast::DataType> results(numThreads);
+        std::vector<std::thread> threads = {};
+        for (int i = 0; i < numThreads; i++) {
+            threads.emplace_back([&results, i]() {
+                for (int j = 0; j < 1000; j++) {
+                    ast::DataType("Type" + std::to_string(j));
+                }
+                results[i] = ast::DataType("Type999");
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (const auto &result : results) {
+            REQUIRE(result == results[0]);
+        }
+    }
+}
@@ -6,7 +6,8 @@
 
 Lexer getLexer(const std::vector<std::string> &lines, Logger &logger) {
     CodeProvider *codeProvider = new StringCodeProvider(lines, false);
-    auto lexer = Lexer(codeProvider, logger);
+    auto *symbolTable = new SymbolTable();
+    auto lexer = Lexer(codeProvider, *symbolTable, logger);
     return lexer;
 }
 
@@ -25,7 +26,7 @@ bool tokensCanBeLexed(const std::vector<std::pair<std::string, Token::TokenType>
         if (actualToken.type != expectedToken.second) {
             return false;
         }
-        UNSCOPED_INFO(actualToken.content + " != " + expectedToken.first);
+        UNSCOPED_INFO(std::string(actualToken.content) + " != " + expectedToken.first);
         if (actualToken.content != expectedToken.first) {
             return false;
         }
@@ -118,7 +119,11 @@ TEST_CASE("Lexer") {
               {"int", Token::SIMPLE_DATA_TYPE},
               {"float", Token::SIMPLE_DATA_TYPE},
               {"string", Token::SIMPLE_DATA_TYPE},
+              {"true", Token::BOOLEAN},
+              {"false", Token::BOOLEAN},
               {"fun", Token::FUN},
+              {"type", Token::TYPE},
+              {"return", Token::RETURN},
               {"extern", Token::EXTERN},
               {"if", Token::IF},
               {"else", Token::ELSE},
@@ -139,6 +144,64 @@ TEST_CASE("Lexer") {
         REQUIRE(tokensCanBeLexed(tokens));
     }
 
+    SECTION("can handle variable names that start with a keyword") {
+        std::vector<std::pair<std::string, Token::TokenType>> tokens = {
+              {"integer", Token::IDENTIFIER},
+              {"format", Token::IDENTIFIER},
+              {"iffy", Token::IDENTIFIER},
+              {"notes", Token::IDENTIFIER},
+              {"order", Token::IDENTIFIER},
+              {"trueValue", Token::IDENTIFIER},
+              {"return_", Token::IDENTIFIER},
+              {"import2", Token::IDENTIFIER},
+        };
+        REQUIRE(tokensCanBeLexed(tokens));
+    }
+
+    SECTION("can handle variable names that are similar to keywords") {
+        std::vector<std::pair<std::string, Token::TokenType>> tokens = {
+              {"i", Token::IDENTIFIER},
+              {"in", Token::IDENTIFIER},
+              {"typ", Token::IDENTIFIER},
+              {"tyre", Token::IDENTIFIER},
+              {"Int", Token::IDENTIFIER},
+              {"strings", Token::IDENTIFIER},
+              {"externs", Token::IDENTIFIER},
+        };
+        REQUIRE(tokensCanBeLexed(tokens));
+    }
+
+    SECTION("can handle keywords followed by other tokens") {
+        std::vector<std::string> lines = {"int(x)"};
+        Logger logger = {};
+        auto lexer = getLexer(lines, logger);
+        auto token = lexer.getToken();
+        REQUIRE(token.type == Token::SIMPLE_DATA_TYPE);
+        REQUIRE(token.content == "int");
+
+        token = lexer.getToken();
+        REQUIRE(token.type == Token::LEFT_PARAN);
+
+        token = lexer.getToken();
+        REQUIRE(token.type == Token::IDENTIFIER);
+        REQUIRE(token.content == "x");
+    }
+
+    SECTION("interns identifiers into symbols") {
+        std::vector<std::string> lines = {"abc def abc int"};
+        Logger logger = {};
+        auto lexer = getLexer(lines, logger);
+        auto first = lexer.getToken();
+        auto second = lexer.getToken();
+        auto third = lexer.getToken();
+        auto keyword = lexer.getToken();
+        REQUIRE(first.symbol != 0);
+        REQUIRE(second.symbol != 0);
+        REQUIRE(first.symbol != second.symbol);
+        REQUIRE(first.symbol == third.symbol);
+        REQUIRE(keyword.symbol == 0);
+    }
+
     SECTION("can handle strings") {
         std::vector<std::pair<std::string, Token::TokenType>> tokens = {
               {"\"myString\"", Token::STRING},
@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ModuleCache.h"
+#include "compiler/parser/Parser.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+std::filesystem::path createSourceFile(const std::filesystem::path &directory) {
+    const auto filePath = directory / "cached.ne";
+    std::ofstream outfile(filePath);
+    outfile << "# a module that is stored in the cache\n"
+               "type Point {\n"
+               "    int x\n"
+               "    int y\n"
+               "}\n"
+               "fun add(int a, int b) int {\n"
+               "    return a + b\n"
+               "}\n"
+               "string s = \"hello\"\n"
+               "int result = add(1, 2)\n";
+    return filePath;
+}
+
+Module *parseModule(const std::filesystem::path &filePath, SymbolTable &symbolTable, const Logger &logger) {
+    auto *module = new Module(filePath);
+    Lexer lexer(module->getCodeProvider(), symbolTable, logger);
+    Parser parser(logger, lexer);
+    parser.run(module);
+    return module;
+}
+
+} // namespace
+
+TEST_CASE("Module Cache") {
+    const auto directory = std::filesystem::temp_directory_path() / "neon-module-cache-test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto filePath = createSourceFile(directory);
+    // NOTE the cache file is placed next to the path of the module inside of the build directory
+    const BuildEnv buildEnv(directory.string());
+
+    Logger logger = {};
+    logger.setLogLevel(Logger::LogLevel::ERROR);
+    SymbolTable symbolTable = {};
+    auto *parsedModule = parseModule(filePath, symbolTable, logger);
+    REQUIRE(parsedModule->ast.is_complete());
+
+    const auto sourceHash = ModuleCache::hashSource(filePath);
+    REQUIRE(sourceHash.has_value());
+    std::filesystem::create_directories(directory.string() + "/" + filePath.parent_path().string());
+    ModuleCache(&buildEnv, symbolTable, logger).store(parsedModule, *sourceHash);
+
+    SECTION("loads the same tree into another symbol table") {
+        SymbolTable otherSymbolTable = {};
+        otherSymbolTable.intern("a symbol that shifts all following symbols");
+        auto *module = new Module(filePath);
+        REQUIRE(ModuleCache(&buildEnv, otherSymbolTable, logger).load(module, *sourceHash));
+        REQUIRE(module->ast.is_complete());
+
+        const auto &expected = parsedModule->ast;
+        const auto &actual = module->ast;
+        REQUIRE(actual.size() == expected.size());
+        for (AstNodeID id = 0; id < expected.size(); id++) {
+            auto *expectedNode = expected.get(id);
+            auto *actualNode = actual.get(id);
+            REQUIRE(actualNode->type == expectedNode->type);
+            if (auto *symbol = symbolOf(expectedNode)) {
+                REQUIRE(otherSymbolTable.get(*symbolOf(actualNode)) == symbolTable.get(*symbol));
+            }
+            if (auto *dataType = dataTypeOf(expectedNode)) {
+                REQUIRE(*dataTypeOf(actualNode) == *dataType);
+            }
+            if (expectedNode->type == ast::NodeType::LITERAL && expectedNode->literal.type == LiteralType::STRING) {
+                REQUIRE(actual.string(actualNode->literal.s) == expected.string(expectedNode->literal.s));
+            }
+        }
+        REQUIRE(actual.nodes(actual.get(AST::ROOT_ID)->sequence.children).size() ==
+                expected.nodes(expected.get(AST::ROOT_ID)->sequence.children).size());
+    }
+
+    SECTION("ignores entries of changed source files") {
+        auto *module = new Module(filePath);
+        REQUIRE_FALSE(ModuleCache(&buildEnv, symbolTable, logger).load(module, *sourceHash + 1));
+        REQUIRE_FALSE(module->ast.is_complete());
+    }
+
+    SECTION("ignores entries with links out of range") {
+        auto *root = parsedModule->ast.get(AST::ROOT_ID);
+        root->sequence.children.count = static_cast<uint32_t>(parsedModule->ast.listData().size() + 1);
+        ModuleCache(&buildEnv, symbolTable, logger).store(parsedModule, *sourceHash);
+
+        auto *module = new Module(filePath);
+        REQUIRE_FALSE(ModuleCache(&buildEnv, symbolTable, logger).load(module, *sourceHash));
+        REQUIRE_FALSE(module->ast.is_complete());
+    }
+
+    SECTION("writes the same entry for the same source") {
+        const auto cacheFilePath = directory.string() + filePath.string() + ".ast";
+        const auto readCacheFile = [&cacheFilePath]() {
+            std::ifstream infile(cacheFilePath, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+        };
+        const auto firstEntry = readCacheFile();
+
+        auto *module = parseModule(filePath, symbolTable, logger);
+        ModuleCache(&buildEnv, symbolTable, logger).store(module, *sourceHash);
+        REQUIRE(readCacheFile() == firstEntry);
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,28 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/ast/AST.h"
+#include "compiler/ast/NodeMap.h"
+
+TEST_CASE("Node Map") {
+    AST tree = {};
+    auto *first = AST_NODE(tree.createLiteralInteger(1));
+    auto *second = AST_NODE(tree.createLiteralInteger(2));
+
+    SECTION("stores one value per node") {
+        NodeMap<ast::DataType> map(tree.size());
+        map[first] = ast::DataType(ast::SimpleDataType::INTEGER);
+        map[second] = ast::DataType(ast::SimpleDataType::FLOAT);
+        REQUIRE(map.get(first) == ast::DataType(ast::SimpleDataType::INTEGER));
+        REQUIRE(map.get(second) == ast::DataType(ast::SimpleDataType::FLOAT));
+        REQUIRE(map.get(tree.root()) == ast::DataType());
+    }
+
+    SECTION("grows for nodes that were created later") {
+        NodeMap<int> map = {};
+        REQUIRE(map.get(second) == 0);
+        auto *third = AST_NODE(tree.createLiteralInteger(3));
+        map[third] = 3;
+        REQUIRE(map.get(third) == 3);
+        REQUIRE(map.get(first) == 0);
+    }
+}
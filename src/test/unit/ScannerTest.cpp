@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/lexer/Scanner.h"
+
+#include <random>
+#include <vector>
+
+std::vector<std::string> getScannerInputs() {
+    std::vector<std::string> inputs = {
+          "",
+          " ",
+          "\t \t  x",
+          "abc_DEF_123 = 5",
+          "1234567890.5",
+          "# a comment\n",
+          "# a comment\r\n",
+          "\"a string\" and more",
+          std::string(100, ' ') + "x",
+          std::string(100, 'a') + "-",
+          std::string(100, '7') + "a",
+          std::string(100, '#') + "\n",
+          "Z[`{@/:" + std::string(40, 'z'),
+          "\xff\xc1\xe1\x80 non ascii",
+    };
+
+    std::mt19937 generator(42);
+    const std::string alphabet = " \t\n\r_azAZ09#\"[`{@/:\xc1\xe1";
+    std::uniform_int_distribution<size_t> characterDistribution(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> lengthDistribution(0, 100);
+    for (int i = 0; i < 200; i++) {
+        std::string input;
+        const auto length = lengthDistribution(generator);
+        for (size_t j = 0; j < length; j++) {
+            input += alphabet[characterDistribution(generator)];
+        }
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+TEST_CASE("Scanner") {
+    const auto inputs = getScannerInputs();
+    const auto originalImplementation = getScannerImplementation();
+
+    std::vector<std::vector<size_t>> expected = {};
+    setScannerImplementation(ScannerImplementation::SCALAR);
+    for (const auto &input : inputs) {
+        for (size_t position = 0; position <= input.size(); position++) {
+            expected.push_back({
+                  skipWhitespace(input, position),
+                  skipDigits(input, position),
+                  skipIdentifierPart(input, position),
+                  findLineTerminator(input, position),
+            });
+        }
+    }
+
+    SECTION("scalar implementation matches the character classes") {
+        REQUIRE(skipWhitespace(" \t x", 0) == 3);
+        REQUIRE(skipDigits("123.5", 0) == 3);
+        REQUIRE(skipIdentifierPart("abc_DEF_123 = 5", 0) == 11);
+        REQUIRE(findLineTerminator("# comment\r\n", 0) == 9);
+        REQUIRE(findLineTerminator("# comment", 0) == 9);
+    }
+
+    for (auto implementation : {ScannerImplementation::SSE2, ScannerImplementation::AVX2}) {
+        if (!isSupported(implementation)) {
+            continue;
+        }
+
+        SECTION(to_string(implementation) + " implementation matches the scalar implementation") {
+            setScannerImplementation(implementation);
+            size_t i = 0;
+            for (const auto &input : inputs) {
+                for (size_t position = 0; position <= input.size(); position++) {
+                    UNSCOPED_INFO("input: '" + input + "', position: " + std::to_string(position));
+                    REQUIRE(skipWhitespace(input, position) == expected[i][0]);
+                    REQUIRE(skipDigits(input, position) == expected[i][1]);
+                    REQUIRE(skipIdentifierPart(input, position) == expected[i][2]);
+                    REQUIRE(findLineTerminator(input, position) == expected[i][3]);
+                    i++;
+                }
+            }
+        }
+    }
+
+    setScannerImplementation(originalImplementation);
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+
+#include "compiler/SymbolIndex.h"
+
+TEST_CASE("Symbol Index") {
+    // NOTE the modules are never freed, so the program has to outlive the test
+    auto *program = new Program();
+    auto *main = new Module("main.ne");
+    auto *first = new Module("first.ne");
+    auto *second = new Module("second.ne");
+    program->modules = {{"main.ne", main}, {"first.ne", first}, {"second.ne", second}};
+
+    const auto shared = program->symbolTable.intern("shared");
+    const auto onlyInSecond = program->symbolTable.intern("onlyInSecond");
+    const auto point = ast::DataType("Point");
+    const auto x = program->symbolTable.intern("x");
+    const auto y = program->symbolTable.intern("y");
+
+    std::unordered_map<Module *, ModuleCompileState> moduleCompileState = {};
+    moduleCompileState[main].imports = {"first.ne", "second.ne", "missing.ne"};
+    moduleCompileState[second].imports = {"first.ne"};
+    moduleCompileState[first].functions = {{.name = shared, .returnType = ast::DataType(ast::SimpleDataType::INTEGER)}};
+    moduleCompileState[second].functions = {{.name = shared, .returnType = ast::DataType(ast::SimpleDataType::FLOAT)},
+                                            {.name = onlyInSecond, .returnType = ast::DataType()}};
+    moduleCompileState[second].complexTypes = {
+          {.type = point,
+           .members = {{.name = x, .type = ast::DataType(ast::SimpleDataType::FLOAT)},
+                       {.name = y, .type = ast::DataType(ast::SimpleDataType::FLOAT)}}}};
+
+    SymbolIndex symbolIndex = {};
+    symbolIndex.build(program, moduleCompileState);
+
+    SECTION("finds functions of imported modules in the order of the imports") {
+        auto result = symbolIndex.findFunction(main, shared);
+        REQUIRE(result.functionExists);
+        REQUIRE(result.module == first);
+        REQUIRE(result.signature == &moduleCompileState[first].functions[0]);
+
+        result = symbolIndex.findFunction(main, onlyInSecond);
+        REQUIRE(result.functionExists);
+        REQUIRE(result.module == second);
+    }
+
+    SECTION("prefers the declarations of the module itself") {
+        auto result = symbolIndex.findFunction(second, shared);
+        REQUIRE(result.functionExists);
+        REQUIRE(result.signature->returnType == ast::DataType(ast::SimpleDataType::FLOAT));
+    }
+
+    SECTION("finds types") {
+        auto result = symbolIndex.findType(main, point);
+        REQUIRE(result.typeExists);
+        REQUIRE(result.complexType == &moduleCompileState[second].complexTypes[0]);
+        REQUIRE_FALSE(symbolIndex.findType(first, point).typeExists);
+    }
+
+    SECTION("shares one member layout per type") {
+        auto result = symbolIndex.findType(main, point);
+        REQUIRE(result.layout == symbolIndex.findType(second, point).layout);
+        REQUIRE(result.layout->complexType == result.complexType);
+        REQUIRE(result.layout->memberIndex(x) == 0);
+        REQUIRE(result.layout->memberIndex(y) == 1);
+        REQUIRE(result.layout->memberIndex(shared) == -1);
+    }
+
+    SECTION("does not see the declarations of modules that are not imported") {
+        REQUIRE_FALSE(symbolIndex.findFunction(first, onlyInSecond).functionExists);
+        REQUIRE_FALSE(symbolIndex.findFunction(main, program->symbolTable.intern("unknown")).functionExists);
+    }
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+
+#include "util/ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Thread Pool") {
+    SECTION("runs all submitted tasks") {
+        std::atomic<int> count = 0;
+        ThreadPool threadPool(4);
+        for (int i = 0; i < 100; i++) {
+            threadPool.submit([&count]() { count++; });
+        }
+        threadPool.wait();
+        REQUIRE(count == 100);
+    }
+
+    SECTION("waits for tasks that are submitted by other tasks") {
+        std::atomic<int> count = 0;
+        ThreadPool threadPool(3);
+        std::function<void(int)> spawn = [&](int depth) {
+            count++;
+            if (depth == 0) {
+                return;
+            }
+            threadPool.submit([&spawn, depth]() { spawn(depth - 1); });
+            threadPool.submit([&spawn, depth]() { spawn(depth - 1); });
+        };
+        threadPool.submit([&spawn]() { spawn(6); });
+        threadPool.wait();
+        // a full binary tree of depth 6
+        REQUIRE(count == 127);
+    }
+
+    SECTION("waits for the task that submitted other tasks") {
+        std::atomic<bool> outerFinished = false;
+        ThreadPool threadPool(4);
+        threadPool.submit([&]() {
+            for (int i = 0; i < 1000; i++) {
+                threadPool.submit([]() {});
+            }
+            // give the other workers time to finish the inner tasks first
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            outerFinished = true;
+        });
+        threadPool.wait();
+        REQUIRE(outerFinished);
+    }
+
+    SECTION("can be used with a single thread") {
+        int count = 0;
+        ThreadPool threadPool(1);
+        threadPool.submit([&]() {
+            threadPool.submit([&count]() { count++; });
+            count++;
+        });
+        threadPool.wait();
+        REQUIRE(count == 2);
+    }
+}
@@ -1,5 +1,6 @@
 #include "ParserTestHelper.h"
 
+#include "compiler/ast/AST.h"
 #include "compiler/ast/AstNode.h"
 #include "compiler/ast/visitors/AstPrinter.h"
 #include "compiler/parser/Parser.h"
@@ -44,118 +45,118 @@ SimpleTree *createSimpleFromSpecification(const std::vector<AstNodeSpec> &spec,
     return node;
 }
 
-SimpleTree *createSimpleFromSequence(SequenceNode *node) {
+SimpleTree *createSimpleFromSequence(const AST &tree, SequenceNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::SEQUENCE;
-    for (auto child : node->children) {
-        result->children.push_back(createSimpleFromAst(child));
+    for (auto child : tree.nodes(node->children)) {
+        result->children.push_back(createSimpleFromAst(tree, child));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromStatement(StatementNode *node) {
+SimpleTree *createSimpleFromStatement(const AST &tree, StatementNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::STATEMENT;
-    result->children.push_back(createSimpleFromAst(node->child));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->child)));
     return result;
 }
 
-SimpleTree *createSimpleFromUnary(UnaryOperationNode *node) {
+SimpleTree *createSimpleFromUnary(const AST &tree, UnaryOperationNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::UNARY_OPERATION;
-    result->children.push_back(createSimpleFromAst(node->child));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->child)));
     return result;
 }
 
-SimpleTree *createSimpleFromBinary(BinaryOperationNode *node) {
+SimpleTree *createSimpleFromBinary(const AST &tree, BinaryOperationNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::BINARY_OPERATION;
-    result->children.push_back(createSimpleFromAst(node->left));
-    result->children.push_back(createSimpleFromAst(node->right));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->left)));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->right)));
     return result;
 }
 
-SimpleTree *createSimpleFromFunction(FunctionNode *node) {
+SimpleTree *createSimpleFromFunction(const AST &tree, FunctionNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::FUNCTION;
-    for (auto argument : node->arguments) {
-        result->children.push_back(createSimpleFromAst(AST_NODE(argument)));
+    for (auto argument : tree.nodes(node->arguments)) {
+        result->children.push_back(createSimpleFromAst(tree, argument));
     }
     if (!node->is_external()) {
-        result->children.push_back(createSimpleFromAst(node->body));
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->body)));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromAssignment(AssignmentNode *node) {
+SimpleTree *createSimpleFromAssignment(const AST &tree, AssignmentNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::ASSIGNMENT;
-    result->children.push_back(createSimpleFromAst(node->left));
-    result->children.push_back(createSimpleFromAst(node->right));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->left)));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->right)));
     return result;
 }
 
-SimpleTree *createSimpleFromCall(CallNode *node) {
+SimpleTree *createSimpleFromCall(const AST &tree, CallNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::CALL;
-    for (auto argument : node->arguments) {
-        result->children.push_back(createSimpleFromAst(argument));
+    for (auto argument : tree.nodes(node->arguments)) {
+        result->children.push_back(createSimpleFromAst(tree, argument));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromIf(IfStatementNode *node) {
+SimpleTree *createSimpleFromIf(const AST &tree, IfStatementNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::IF_STATEMENT;
-    result->children.push_back(createSimpleFromAst(node->condition));
-    if (node->ifBody != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->ifBody));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->condition)));
+    if (node->ifBody != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->ifBody)));
     }
-    if (node->elseBody != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->elseBody));
+    if (node->elseBody != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->elseBody)));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromFor(ForStatementNode *node) {
+SimpleTree *createSimpleFromFor(const AST &tree, ForStatementNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::FOR_STATEMENT;
-    if (node->init != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->init));
+    if (node->init != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->init)));
     }
-    if (node->condition != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->condition));
+    if (node->condition != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->condition)));
     }
-    if (node->update != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->update));
+    if (node->update != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->update)));
     }
-    if (node->body != nullptr) {
-        result->children.push_back(createSimpleFromAst(node->body));
+    if (node->body != NO_NODE) {
+        result->children.push_back(createSimpleFromAst(tree, tree.get(node->body)));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromTypeDeclaration(TypeDeclarationNode *node) {
+SimpleTree *createSimpleFromTypeDeclaration(const AST &tree, TypeDeclarationNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::TYPE_DECLARATION;
-    for (const auto &member : node->members) {
-        result->children.push_back(createSimpleFromAst(AST_NODE(member)));
+    for (auto member : tree.nodes(node->members)) {
+        result->children.push_back(createSimpleFromAst(tree, member));
     }
     return result;
 }
 
-SimpleTree *createSimpleFromAssert(AssertNode *node) {
+SimpleTree *createSimpleFromAssert(const AST &tree, AssertNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::ASSERT;
-    result->children.push_back(createSimpleFromAst(node->condition));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->condition)));
     return result;
 }
 
-SimpleTree *createSimpleFromMemberAccess(MemberAccessNode *node) {
+SimpleTree *createSimpleFromMemberAccess(const AST &tree, MemberAccessNode *node) {
     auto result = new SimpleTree();
     result->type = ast::NodeType::MEMBER_ACCESS;
-    result->children.push_back(createSimpleFromAst(node->left));
-    result->children.push_back(createSimpleFromAst(node->right));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->left)));
+    result->children.push_back(createSimpleFromAst(tree, tree.get(node->right)));
     return result;
 }
 
@@ -165,7 +166,7 @@ SimpleTree *createSimpleFromNode(AstNode *node) {
     return result;
 }
 
-SimpleTree *createSimpleFromAst(AstNode *node) {
+SimpleTree *createSimpleFromAst(const AST &tree, AstNode *node) {
     if (node == nullptr) {
         return nullptr;
     }
@@ -178,29 +179,29 @@ SimpleTree *createSimpleFromAst(AstNode *node) {
     case ast::NodeType::COMMENT:
         return createSimpleFromNode(node);
     case ast::NodeType::SEQUENCE:
-        return createSimpleFromSequence((SequenceNode *)node);
+        return createSimpleFromSequence(tree, (SequenceNode *)node);
     case ast::NodeType::STATEMENT:
-        return createSimpleFromStatement((StatementNode *)node);
+        return createSimpleFromStatement(tree, (StatementNode *)node);
     case ast::NodeType::UNARY_OPERATION:
-        return createSimpleFromUnary((UnaryOperationNode *)node);
+        return createSimpleFromUnary(tree, (UnaryOperationNode *)node);
     case ast::NodeType::BINARY_OPERATION:
-        return createSimpleFromBinary((BinaryOperationNode *)node);
+        return createSimpleFromBinary(tree, (BinaryOperationNode *)node);
     case ast::NodeType::FUNCTION:
-        return createSimpleFromFunction((FunctionNode *)node);
+        return createSimpleFromFunction(tree, (FunctionNode *)node);
     case ast::NodeType::ASSIGNMENT:
-        return createSimpleFromAssignment((AssignmentNode *)node);
+        return createSimpleFromAssignment(tree, (AssignmentNode *)node);
     case ast::NodeType::CALL:
-        return createSimpleFromCall((CallNode *)node);
+        return createSimpleFromCall(tree, (CallNode *)node);
     case ast::NodeType::IF_STATEMENT:
-        return createSimpleFromIf((IfStatementNode *)node);
+        return createSimpleFromIf(tree, (IfStatementNode *)node);
     case ast::NodeType::FOR_STATEMENT:
-        return createSimpleFromFor((ForStatementNode *)node);
+        return createSimpleFromFor(tree, (ForStatementNode *)node);
     case ast::NodeType::TYPE_DECLARATION:
-        return createSimpleFromTypeDeclaration((TypeDeclarationNode *)node);
+        return createSimpleFromTypeDeclaration(tree, (TypeDeclarationNode *)node);
     case ast::NodeType::MEMBER_ACCESS:
-        return createSimpleFromMemberAccess((MemberAccessNode *)node);
+        return createSimpleFromMemberAccess(tree, (MemberAccessNode *)node);
     case ast::NodeType::ASSERT:
-        return createSimpleFromAssert((AssertNode *)node);
+        return createSimpleFromAssert(tree, (AssertNode *)node);
     default:
         std::cerr << "Could not create simple helper tree node for " << to_string(node->type) << std::endl;
         exit(1);
@@ -211,23 +212,53 @@ SimpleTree *createSimpleFromAst(AstNode *node) {
 bool parserCreatesCorrectAst(const std::vector<std::string> &program, std::vector<AstNodeSpec> &spec) {
     int index = 0;
     auto expected = createSimpleFromSpecification(spec, index);
-    CodeProvider *codeProvider = new StringCodeProvider(program, true);
-    auto context = new llvm::LLVMContext();
-    auto prog = new Module("test.ne", *context);
-    Logger logger = {};
-    logger.setColorEnabled(false);
-    auto lexer = Lexer(codeProvider, logger);
-
-    Parser parser(logger, lexer);
-    parser.run(prog);
-
-    /*
-     * TODO activate this again
-        auto astPrinter = AstPrinter(prog);
-        std::string result = astPrinter.run();
-        UNSCOPED_INFO(result);
-    */
-
-    auto actual = prog->ast.root();
-    return astsAreEqual(expected, createSimpleFromAst(actual), 0);
+
+    // the parser has to create the same tree, no matter where the tokens are coming from and how many threads parse them
+    const std::vector<ParserOptions> allOptions = {
+          {},
+          {.lexInBackground = true},
+          {.parseThreads = 4, .minimumBatchSize = 1},
+    };
+    // NOTE the first parse is sequential, the node IDs of all other parses have to match it
+    const AST *sequentialTree = nullptr;
+    for (const auto &options : allOptions) {
+        CodeProvider *codeProvider = new StringCodeProvider(program, true);
+        auto prog = new Module("test.ne");
+        Logger logger = {};
+        logger.setColorEnabled(false);
+        SymbolTable symbolTable = {};
+        auto lexer = Lexer(codeProvider, symbolTable, logger);
+
+        Parser parser(logger, lexer, options);
+        parser.run(prog);
+
+        /*
+         * TODO activate this again
+            auto astPrinter = AstPrinter(prog);
+            std::string result = astPrinter.run();
+            UNSCOPED_INFO(result);
+        */
+
+        auto actual = prog->ast.root();
+        if (!astsAreEqual(expected, createSimpleFromAst(prog->ast, actual), 0)) {
+            return false;
+        }
+
+        if (sequentialTree == nullptr) {
+            sequentialTree = &prog->ast;
+            continue;
+        }
+        if (prog->ast.size() != sequentialTree->size()) {
+            UNSCOPED_INFO("expected " + std::to_string(sequentialTree->size()) + " nodes, got " +
+                          std::to_string(prog->ast.size()));
+            return false;
+        }
+        for (AstNodeID id = 0; id < prog->ast.size(); id++) {
+            if (prog->ast.get(id)->type != sequentialTree->get(id)->type) {
+                UNSCOPED_INFO("node " + std::to_string(id) + " has a different type than in the sequential tree");
+                return false;
+            }
+        }
+    }
+    return true;
 }
@@ -15,6 +15,6 @@ struct SimpleTree {
     std::vector<SimpleTree *> children = {};
 };
 
-SimpleTree *createSimpleFromAst(AstNode *node);
+SimpleTree *createSimpleFromAst(const AST &tree, AstNode *node);
 
 bool parserCreatesCorrectAst(const std::vector<std::string> &program, std::vector<AstNodeSpec> &spec);